@@ -0,0 +1,393 @@
+#include "bplus_tree.h"
+#include <cstring>
+#include <algorithm>
+
+constexpr int BPlusTree::LEAF_CAPACITY;
+constexpr int BPlusTree::INNER_CAPACITY;
+
+static size_t commonPrefixLength(const char* a, size_t aLength, const char* b, size_t bLength) {
+    size_t limit = std::min(aLength, bLength);
+    size_t i = 0;
+    while (i < limit && a[i] == b[i]) {
+        i++;
+    }
+    return i;
+}
+
+// Сравнение как у std::string: побайтово без знака, затем по длине
+static int compareBytes(const char* a, size_t aLength, const char* b, size_t bLength) {
+    int result = std::memcmp(a, b, std::min(aLength, bLength));
+    if (result != 0) {
+        return result;
+    }
+    return aLength < bLength ? -1 : (aLength > bLength ? 1 : 0);
+}
+
+int BPlusTree::KeyBlock::compareSuffix(int i, const char* data, size_t length) const {
+    return compareBytes(bytes.data() + suffixBegin(i), suffixLength(i), data, length);
+}
+
+int BPlusTree::KeyBlock::position(const std::string& key, bool upper) const {
+    // Ключ, не начинающийся с общего префикса, меньше или больше сразу всех ключей узла
+    size_t prefixLength = prefix.size();
+    int result = std::memcmp(key.data(), prefix.data(), std::min(key.size(), prefixLength));
+    if (result < 0 || (result == 0 && key.size() < prefixLength)) {
+        return 0;
+    }
+    if (result > 0) {
+        return count();
+    }
+    
+    const char* rest = key.data() + prefixLength;
+    size_t restLength = key.size() - prefixLength;
+    int low = 0, high = count();
+    while (low < high) {
+        int mid = (low + high) / 2;
+        int cmp = compareSuffix(mid, rest, restLength);
+        if (cmp < 0 || (upper && cmp == 0)) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+bool BPlusTree::KeyBlock::equals(int i, const std::string& key) const {
+    size_t prefixLength = prefix.size();
+    return key.size() == prefixLength + suffixLength(i) &&
+           std::memcmp(key.data(), prefix.data(), prefixLength) == 0 &&
+           std::memcmp(key.data() + prefixLength, bytes.data() + suffixBegin(i), suffixLength(i)) == 0;
+}
+
+void BPlusTree::KeyBlock::keyAt(int i, std::string& out) const {
+    out.assign(prefix);
+    out.append(bytes, suffixBegin(i), suffixLength(i));
+}
+
+std::string BPlusTree::KeyBlock::keyAt(int i) const {
+    std::string result;
+    keyAt(i, result);
+    return result;
+}
+
+void BPlusTree::KeyBlock::shrinkPrefix(size_t length) {
+    // Отрезанная часть префикса возвращается в начало каждого суффикса
+    std::string extra = prefix.substr(length);
+    std::string rebuilt;
+    rebuilt.reserve(bytes.size() + extra.size() * count());
+    size_t begin = 0;
+    for (int i = 0; i < count(); i++) {
+        size_t end = ends[i];
+        rebuilt.append(extra);
+        rebuilt.append(bytes, begin, end - begin);
+        ends[i] = rebuilt.size();
+        begin = end;
+    }
+    bytes.swap(rebuilt);
+    prefix.resize(length);
+}
+
+void BPlusTree::KeyBlock::tighten() {
+    if (count() == 0) return;
+    
+    // Ключи упорядочены, поэтому общий префикс всех — общий префикс крайних
+    int last = count() - 1;
+    size_t extra = commonPrefixLength(bytes.data(), suffixLength(0),
+                                      bytes.data() + suffixBegin(last), suffixLength(last));
+    if (extra == 0) return;
+    
+    prefix.append(bytes, 0, extra);
+    std::string rebuilt;
+    rebuilt.reserve(bytes.size() - extra * count());
+    size_t begin = 0;
+    for (int i = 0; i < count(); i++) {
+        size_t end = ends[i];
+        rebuilt.append(bytes, begin + extra, end - begin - extra);
+        ends[i] = rebuilt.size();
+        begin = end;
+    }
+    bytes.swap(rebuilt);
+}
+
+void BPlusTree::KeyBlock::insert(int pos, const std::string& key) {
+    if (count() == 0) {
+        prefix = key;
+        bytes.clear();
+        ends.assign(1, 0);
+        return;
+    }
+    
+    size_t common = commonPrefixLength(prefix.data(), prefix.size(), key.data(), key.size());
+    if (common < prefix.size()) {
+        shrinkPrefix(common);
+    }
+    
+    size_t begin = suffixBegin(pos);
+    size_t length = key.size() - prefix.size();
+    bytes.insert(begin, key, prefix.size(), length);
+    ends.insert(ends.begin() + pos, begin + length);
+    for (int i = pos + 1; i < count(); i++) {
+        ends[i] += length;
+    }
+}
+
+void BPlusTree::KeyBlock::erase(int pos) {
+    size_t begin = suffixBegin(pos);
+    size_t length = suffixLength(pos);
+    bytes.erase(begin, length);
+    ends.erase(ends.begin() + pos);
+    for (int i = pos; i < count(); i++) {
+        ends[i] -= length;
+    }
+}
+
+void BPlusTree::KeyBlock::moveTail(int from, KeyBlock& target) {
+    size_t begin = suffixBegin(from);
+    target.prefix = prefix;
+    target.bytes.assign(bytes, begin, std::string::npos);
+    target.ends.clear();
+    for (int i = from; i < count(); i++) {
+        target.ends.push_back(ends[i] - begin);
+    }
+    
+    bytes.resize(begin);
+    ends.resize(from);
+    
+    // После разделения у каждой половины общий префикс может стать длиннее
+    tighten();
+    target.tighten();
+}
+
+BPlusTree::BPlusTree() : root(nullptr), firstLeaf(nullptr), count(0) {}
+
+BPlusTree::~BPlusTree() {
+    clear();
+}
+
+void BPlusTree::clear() {
+    destroyTree(root);
+    root = nullptr;
+    firstLeaf = nullptr;
+    count = 0;
+}
+
+void BPlusTree::destroyTree(Node* node) {
+    if (node == nullptr) return;
+    
+    if (node->leaf) {
+        delete static_cast<LeafNode*>(node);
+    } else {
+        InnerNode* inner = static_cast<InnerNode*>(node);
+        for (Node* child : inner->children) {
+            destroyTree(child);
+        }
+        delete inner;
+    }
+}
+
+int BPlusTree::height() const {
+    int levels = 0;
+    for (const Node* node = root; node != nullptr; levels++) {
+        node = node->leaf ? nullptr : static_cast<const InnerNode*>(node)->children[0];
+    }
+    return levels - 1;
+}
+
+const BPlusTree::LeafNode* BPlusTree::findLeaf(const std::string& key) const {
+    const Node* node = root;
+    if (node == nullptr) return nullptr;
+    
+    while (!node->leaf) {
+        const InnerNode* inner = static_cast<const InnerNode*>(node);
+        node = inner->children[inner->keys.upperBound(key)];
+    }
+    return static_cast<const LeafNode*>(node);
+}
+
+const std::string* BPlusTree::find(const std::string& key) const {
+    const LeafNode* leaf = findLeaf(key);
+    if (leaf == nullptr) return nullptr;
+    
+    int i = leaf->keys.lowerBound(key);
+    if (i < leaf->keys.count() && leaf->keys.equals(i, key)) {
+        return &leaf->values[i];
+    }
+    return nullptr;
+}
+
+std::string BPlusTree::search(const std::string& key) const {
+    const std::string* value = find(key);
+    return value != nullptr ? *value : "Not Found";
+}
+
+void BPlusTree::splitLeaf(LeafNode* leaf, std::string& splitKey, Node*& splitNode) {
+    int mid = leaf->keys.count() / 2;
+    LeafNode* right = new LeafNode();
+    std::string leftLast = leaf->keys.keyAt(mid - 1);
+    std::string rightFirst = leaf->keys.keyAt(mid);
+    
+    leaf->keys.moveTail(mid, right->keys);
+    right->values.assign(std::make_move_iterator(leaf->values.begin() + mid),
+                         std::make_move_iterator(leaf->values.end()));
+    leaf->values.resize(mid);
+    
+    right->prev = leaf;
+    right->next = leaf->next;
+    if (leaf->next != nullptr) {
+        leaf->next->prev = right;
+    }
+    leaf->next = right;
+    
+    // Разделитель — кратчайший префикс первого правого ключа, больший
+    // последнего левого: внутренние узлы хранят меньше байтов
+    size_t common = commonPrefixLength(leftLast.data(), leftLast.size(),
+                                       rightFirst.data(), rightFirst.size());
+    splitKey = rightFirst.substr(0, common + 1);
+    splitNode = right;
+}
+
+void BPlusTree::splitInner(InnerNode* node, std::string& splitKey, Node*& splitNode) {
+    int mid = node->keys.count() / 2;
+    InnerNode* right = new InnerNode();
+    
+    // Средний разделитель поднимается в родителя
+    splitKey = node->keys.keyAt(mid);
+    node->keys.moveTail(mid + 1, right->keys);
+    node->keys.erase(mid);
+    node->keys.tighten();
+    
+    right->children.assign(node->children.begin() + mid + 1, node->children.end());
+    node->children.resize(mid + 1);
+    splitNode = right;
+}
+
+bool BPlusTree::insertHelper(Node* node, const std::string& key, const std::string& value,
+                             std::string& splitKey, Node*& splitNode) {
+    splitNode = nullptr;
+    
+    if (node->leaf) {
+        LeafNode* leaf = static_cast<LeafNode*>(node);
+        int i = leaf->keys.lowerBound(key);
+        if (i < leaf->keys.count() && leaf->keys.equals(i, key)) {
+            leaf->values[i] = value;
+            return false;
+        }
+        
+        leaf->keys.insert(i, key);
+        leaf->values.insert(leaf->values.begin() + i, value);
+        if (leaf->keys.count() > LEAF_CAPACITY) {
+            splitLeaf(leaf, splitKey, splitNode);
+        }
+        return true;
+    }
+    
+    InnerNode* inner = static_cast<InnerNode*>(node);
+    int i = inner->keys.upperBound(key);
+    std::string childSplitKey;
+    Node* childSplitNode;
+    bool inserted = insertHelper(inner->children[i], key, value, childSplitKey, childSplitNode);
+    
+    if (childSplitNode != nullptr) {
+        inner->keys.insert(i, childSplitKey);
+        inner->children.insert(inner->children.begin() + i + 1, childSplitNode);
+        if (inner->keys.count() > INNER_CAPACITY) {
+            splitInner(inner, splitKey, splitNode);
+        }
+    }
+    return inserted;
+}
+
+void BPlusTree::insert(const std::string& key, const std::string& value) {
+    if (root == nullptr) {
+        firstLeaf = new LeafNode();
+        root = firstLeaf;
+    }
+    
+    std::string splitKey;
+    Node* splitNode;
+    if (insertHelper(root, key, value, splitKey, splitNode)) {
+        count++;
+    }
+    
+    // Разделение корня добавляет уровень
+    if (splitNode != nullptr) {
+        InnerNode* newRoot = new InnerNode();
+        newRoot->keys.insert(0, splitKey);
+        newRoot->children.push_back(root);
+        newRoot->children.push_back(splitNode);
+        root = newRoot;
+    }
+}
+
+void BPlusTree::unlinkLeaf(LeafNode* leaf) {
+    if (leaf->prev != nullptr) {
+        leaf->prev->next = leaf->next;
+    } else {
+        firstLeaf = leaf->next;
+    }
+    if (leaf->next != nullptr) {
+        leaf->next->prev = leaf->prev;
+    }
+}
+
+// Возвращает true, если узел опустел и удалён
+bool BPlusTree::removeHelper(Node* node, const std::string& key, bool& removed) {
+    if (node->leaf) {
+        LeafNode* leaf = static_cast<LeafNode*>(node);
+        int i = leaf->keys.lowerBound(key);
+        if (i == leaf->keys.count() || !leaf->keys.equals(i, key)) {
+            return false;
+        }
+        
+        removed = true;
+        leaf->keys.erase(i);
+        leaf->values.erase(leaf->values.begin() + i);
+        if (leaf->keys.count() > 0) {
+            return false;
+        }
+        
+        unlinkLeaf(leaf);
+        delete leaf;
+        return true;
+    }
+    
+    InnerNode* inner = static_cast<InnerNode*>(node);
+    int i = inner->keys.upperBound(key);
+    if (!removeHelper(inner->children[i], key, removed)) {
+        return false;
+    }
+    
+    // Диапазон удалённого потомка отходит соседу вместе с разделителем
+    inner->children.erase(inner->children.begin() + i);
+    if (inner->keys.count() > 0) {
+        inner->keys.erase(i > 0 ? i - 1 : 0);
+    }
+    if (!inner->children.empty()) {
+        return false;
+    }
+    
+    delete inner;
+    return true;
+}
+
+void BPlusTree::remove(const std::string& key) {
+    if (root == nullptr) return;
+    
+    bool removed = false;
+    if (removeHelper(root, key, removed)) {
+        root = nullptr;
+        firstLeaf = nullptr;
+    }
+    if (removed) {
+        count--;
+    }
+    
+    // Корень с единственным потомком не нужен
+    while (root != nullptr && !root->leaf &&
+           static_cast<InnerNode*>(root)->children.size() == 1) {
+        InnerNode* oldRoot = static_cast<InnerNode*>(root);
+        root = oldRoot->children[0];
+        delete oldRoot;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#ifndef BPLUS_TREE_H
+#define BPLUS_TREE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// B+-дерево со строковыми ключами и строковыми значениями.
+// Узлы широкие (до 64 ключей), и ключи узла лежат подряд в одном буфере,
+// поэтому спуск по уровню — это двоичный поиск по смежной памяти, а не
+// переход по указателю на каждый ключ. Общий префикс ключей узла хранится
+// один раз (префиксное сжатие), разделители во внутренних узлах укорочены
+// до кратчайшего различающего префикса. Листья связаны в список, так что
+// диапазонный просмотр идёт по листьям подряд без возврата к корню.
+// Удаление ленивое: узел освобождается, только когда в нём не осталось
+// ключей, недозаполненные узлы не сливаются
+class BPlusTree {
+private:
+    static constexpr int LEAF_CAPACITY = 64;
+    static constexpr int INNER_CAPACITY = 64;
+    
+    // Упорядоченные ключи узла: общий префикс и суффиксы подряд
+    struct KeyBlock {
+        std::string prefix;
+        std::string bytes;
+        // ends[i] — конец i-го суффикса в bytes
+        std::vector<uint32_t> ends;
+        
+        int count() const { return ends.size(); }
+        size_t suffixBegin(int i) const { return i == 0 ? 0 : ends[i - 1]; }
+        size_t suffixLength(int i) const { return ends[i] - suffixBegin(i); }
+        
+        int compareSuffix(int i, const char* data, size_t length) const;
+        int position(const std::string& key, bool upper) const;
+        int lowerBound(const std::string& key) const { return position(key, false); }
+        int upperBound(const std::string& key) const { return position(key, true); }
+        bool equals(int i, const std::string& key) const;
+        void keyAt(int i, std::string& out) const;
+        std::string keyAt(int i) const;
+        
+        void insert(int pos, const std::string& key);
+        void erase(int pos);
+        void moveTail(int from, KeyBlock& target);
+        void shrinkPrefix(size_t length);
+        void tighten();
+    };
+    
+    struct Node {
+        bool leaf;
+        KeyBlock keys;
+        
+        explicit Node(bool isLeaf) : leaf(isLeaf) {}
+    };
+    
+    struct LeafNode : Node {
+        std::vector<std::string> values;
+        LeafNode* prev;
+        LeafNode* next;
+        
+        LeafNode() : Node(true), prev(nullptr), next(nullptr) {}
+    };
+    
+    // children.size() == keys.count() + 1; ключи, не меньшие keys[i],
+    // лежат правее i-го потомка
+    struct InnerNode : Node {
+        std::vector<Node*> children;
+        
+        InnerNode() : Node(false) {}
+    };
+    
+    Node* root;
+    LeafNode* firstLeaf;
+    int count;
+    
+    // Вспомогательные методы
+    bool insertHelper(Node* node, const std::string& key, const std::string& value,
+                      std::string& splitKey, Node*& splitNode);
+    bool removeHelper(Node* node, const std::string& key, bool& removed);
+    void splitLeaf(LeafNode* leaf, std::string& splitKey, Node*& splitNode);
+    void splitInner(InnerNode* node, std::string& splitKey, Node*& splitNode);
+    void unlinkLeaf(LeafNode* leaf);
+    const LeafNode* findLeaf(const std::string& key) const;
+    void destroyTree(Node* node);
+
+public:
+    // Конструкторы и деструктор
+    BPlusTree();
+    ~BPlusTree();
+    
+    // Запрет копирования
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+    
+    // Основные операции (вставка существующего ключа обновляет значение)
+    void insert(const std::string& key, const std::string& value);
+    std::string search(const std::string& key) const;
+    void remove(const std::string& key);
+    
+    // Поиск без копирования значения (nullptr, если ключа нет)
+    const std::string* find(const std::string& key) const;
+    bool contains(const std::string& key) const { return find(key) != nullptr; }
+    
+    // Обход пар в порядке возрастания ключей: всех или из [low, high).
+    // Посетитель вызывается как visitor(const std::string& key, const std::string& value)
+    template<typename Visitor>
+    void forEach(Visitor visitor) const;
+    template<typename Visitor>
+    void forEachInRange(const std::string& low, const std::string& high, Visitor visitor) const;
+    
+    // Утилиты
+    int getSize() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    int height() const;
+    void clear();
+};
+
+template<typename Visitor>
+void BPlusTree::forEach(Visitor visitor) const {
+    std::string key;
+    for (const LeafNode* leaf = firstLeaf; leaf != nullptr; leaf = leaf->next) {
+        for (int i = 0; i < leaf->keys.count(); i++) {
+            leaf->keys.keyAt(i, key);
+            visitor(static_cast<const std::string&>(key), leaf->values[i]);
+        }
+    }
+}
+
+template<typename Visitor>
+void BPlusTree::forEachInRange(const std::string& low, const std::string& high,
+                               Visitor visitor) const {
+    const LeafNode* leaf = findLeaf(low);
+    if (leaf == nullptr) return;
+    
+    // Ключ собирается в один буфер, чтобы не выделять память на каждую пару
+    std::string key;
+    int i = leaf->keys.lowerBound(low);
+    while (leaf != nullptr) {
+        for (; i < leaf->keys.count(); i++) {
+            leaf->keys.keyAt(i, key);
+            if (!(key < high)) {
+                return;
+            }
+            visitor(static_cast<const std::string&>(key), leaf->values[i]);
+        }
+        leaf = leaf->next;
+        i = 0;
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "concurrent_hash_table.h"
+#include <mutex>
+#include <cstdint>
+
+ConcurrentHashTable::ConcurrentHashTable(int shardCount, int initialCapacity,
+                                         double threshold, HashTable::ProbeMode probe) {
+    if (shardCount <= 0) {
+        shardCount = 16;
+    }
+    
+    shards.reserve(shardCount);
+    for (int i = 0; i < shardCount; i++) {
+        shards.emplace_back(new Shard(initialCapacity, threshold, probe));
+    }
+}
+
+ConcurrentHashTable::Shard& ConcurrentHashTable::shardFor(int key) const {
+    // Сегмент выбирается старшими битами мультипликативного хеша,
+    // чтобы не коррелировать с хешем внутри самой таблицы
+    uint64_t h = static_cast<uint32_t>(key) * 0x9E3779B97F4A7C15ULL;
+    return *shards[(h >> 32) % shards.size()];
+}
+
+void ConcurrentHashTable::insert(int key, const std::string& value) {
+    Shard& shard = shardFor(key);
+    std::unique_lock<std::shared_timed_mutex> lock(shard.mutex);
+    shard.table.insert(key, value);
+}
+
+std::string ConcurrentHashTable::search(int key) const {
+    Shard& shard = shardFor(key);
+    std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+    return shard.table.search(key);
+}
+
+bool ConcurrentHashTable::tryGet(int key, std::string& out) const {
+    Shard& shard = shardFor(key);
+    std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+    const std::string* value = shard.table.find(key);
+    if (value == nullptr) {
+        return false;
+    }
+    out.assign(*value);
+    return true;
+}
+
+bool ConcurrentHashTable::contains(int key) const {
+    Shard& shard = shardFor(key);
+    std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+    return shard.table.contains(key);
+}
+
+void ConcurrentHashTable::remove(int key) {
+    Shard& shard = shardFor(key);
+    std::unique_lock<std::shared_timed_mutex> lock(shard.mutex);
+    shard.table.remove(key);
+}
+
+int ConcurrentHashTable::getSize() const {
+    int total = 0;
+    for (const auto& shard : shards) {
+        std::shared_lock<std::shared_timed_mutex> lock(shard->mutex);
+        total += shard->table.getSize();
+    }
+    return total;
+}
+
+void ConcurrentHashTable::clear() {
+    for (auto& shard : shards) {
+        std::unique_lock<std::shared_timed_mutex> lock(shard->mutex);
+        shard->table.clear();
+    }
+}
+
+HashTable::Stats ConcurrentHashTable::getStats() const {
+    HashTable::Stats total;
+    for (size_t i = 0; i < shards.size(); i++) {
+        std::shared_lock<std::shared_timed_mutex> lock(shards[i]->mutex);
+        if (i == 0) {
+            total = shards[i]->table.getStats();
+        } else {
+            total.merge(shards[i]->table.getStats());
+        }
+    }
+    return total;
+}
\ No newline at end of file
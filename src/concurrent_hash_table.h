@@ -0,0 +1,61 @@
+#ifndef CONCURRENT_HASH_TABLE_H
+#define CONCURRENT_HASH_TABLE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <shared_mutex>
+#include "hash_table.h"
+
+// Хеш-таблица для многопоточного доступа: пространство ключей разбито
+// на независимые сегменты (shards), у каждого своя HashTable и своя
+// блокировка чтения-записи. Читатели одного сегмента не мешают друг другу,
+// писатели разных сегментов не ждут друг друга.
+class ConcurrentHashTable {
+private:
+    struct Shard {
+        mutable std::shared_timed_mutex mutex;
+        HashTable table;
+        // Отступ, чтобы блокировки соседних сегментов не делили кеш-линию
+        char padding[64];
+        
+        Shard(int initialCapacity, double threshold, HashTable::ProbeMode probe)
+            : table(initialCapacity, threshold, HashTable::ResizeMode::Incremental, probe) {}
+    };
+    
+    std::vector<std::unique_ptr<Shard>> shards;
+    
+    Shard& shardFor(int key) const;
+
+public:
+    // Конструктор: число сегментов и параметры таблицы каждого сегмента
+    explicit ConcurrentHashTable(int shardCount = 16, int initialCapacity = 8,
+                                 double threshold = 0.75,
+                                 HashTable::ProbeMode probe = HashTable::ProbeMode::Grouped);
+    
+    // Запрет копирования
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+    
+    // Основные операции (потокобезопасны)
+    void insert(int key, const std::string& value);
+    std::string search(int key) const;
+    void remove(int key);
+    
+    // Поиск без выделения памяти: значение копируется в буфер вызывающего,
+    // который переиспользует свою ёмкость между вызовами
+    bool tryGet(int key, std::string& out) const;
+    bool contains(int key) const;
+    
+    // Утилиты. Размер складывается по сегментам и при параллельных
+    // записях является лишь моментальной оценкой
+    int getSize() const;
+    bool isEmpty() const { return getSize() == 0; }
+    int getShardCount() const { return shards.size(); }
+    void clear();
+    
+    // Статистика, сложенная по всем сегментам
+    HashTable::Stats getStats() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "concurrent_queue.h"
+#include <cstdint>
+
+constexpr size_t SpscQueue::CACHE_LINE;
+constexpr size_t MpmcQueue::CACHE_LINE;
+
+// Ёмкость — степень двойки не меньше 2, чтобы позиция бралась маской
+static size_t roundCapacity(size_t capacity) {
+    size_t rounded = 2;
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+    return rounded;
+}
+
+// ==================== SpscQueue ====================
+
+SpscQueue::SpscQueue(size_t capacity)
+    : slots(roundCapacity(capacity)), mask(slots.size() - 1),
+      head(0), cachedTail(0), tail(0), cachedHead(0) {}
+
+template<typename Value>
+bool SpscQueue::push(Value&& value) {
+    const size_t position = tail.load(std::memory_order_relaxed);
+    if (position - cachedHead == slots.size()) {
+        cachedHead = head.load(std::memory_order_acquire);
+        if (position - cachedHead == slots.size()) {
+            return false;  // Очередь полна
+        }
+    }
+    
+    slots[position & mask] = std::forward<Value>(value);
+    tail.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool SpscQueue::tryEnqueue(const std::string& value) {
+    return push(value);
+}
+
+bool SpscQueue::tryEnqueue(std::string&& value) {
+    return push(std::move(value));
+}
+
+bool SpscQueue::tryDequeue(std::string& out) {
+    const size_t position = head.load(std::memory_order_relaxed);
+    if (position == cachedTail) {
+        cachedTail = tail.load(std::memory_order_acquire);
+        if (position == cachedTail) {
+            return false;  // Очередь пуста
+        }
+    }
+    
+    out = std::move(slots[position & mask]);
+    head.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool SpscQueue::tryPeek(std::string& out) const {
+    const size_t position = head.load(std::memory_order_relaxed);
+    if (position == tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+    out = slots[position & mask];
+    return true;
+}
+
+size_t SpscQueue::getSize() const {
+    const size_t first = head.load(std::memory_order_acquire);
+    const size_t last = tail.load(std::memory_order_acquire);
+    // Потребитель мог обогнать прочитанное значение tail
+    return last > first ? last - first : 0;
+}
+
+// ==================== MpmcQueue ====================
+
+MpmcQueue::MpmcQueue(size_t capacity)
+    : cells(new Cell[roundCapacity(capacity)]), capacity(roundCapacity(capacity)),
+      mask(this->capacity - 1), enqueuePos(0), dequeuePos(0) {
+    // Ячейка i свободна для записи с позиции i
+    for (size_t i = 0; i < this->capacity; i++) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename Value>
+bool MpmcQueue::push(Value&& value) {
+    Cell* cell;
+    size_t position = enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &cells[position & mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0) {
+            // Ячейка свободна: занимаем позицию
+            if (enqueuePos.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            return false;  // Очередь полна: ячейку ещё не освободил потребитель
+        } else {
+            // Позицию занял другой производитель
+            position = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+    
+    cell->data = std::forward<Value>(value);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool MpmcQueue::tryEnqueue(const std::string& value) {
+    return push(value);
+}
+
+bool MpmcQueue::tryEnqueue(std::string&& value) {
+    return push(std::move(value));
+}
+
+bool MpmcQueue::tryDequeue(std::string& out) {
+    Cell* cell;
+    size_t position = dequeuePos.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &cells[position & mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+        if (difference == 0) {
+            // Ячейка заполнена: забираем позицию
+            if (dequeuePos.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            return false;  // Очередь пуста
+        } else {
+            position = dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+    
+    out = std::move(cell->data);
+    // Ячейка освобождается для производителя следующего круга
+    cell->sequence.store(position + capacity, std::memory_order_release);
+    return true;
+}
+
+size_t MpmcQueue::getSize() const {
+    const size_t first = dequeuePos.load(std::memory_order_acquire);
+    const size_t last = enqueuePos.load(std::memory_order_acquire);
+    return last > first ? last - first : 0;
+}
\ No newline at end of file
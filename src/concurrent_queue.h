@@ -0,0 +1,262 @@
+#ifndef CONCURRENT_QUEUE_H
+#define CONCURRENT_QUEUE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstddef>
+#include <utility>
+
+// Ограниченные очереди строк без блокировок для передачи работы между
+// потоками. Ёмкость округляется вверх до степени двойки и не меняется.
+// Операции try* не ждут: при полной очереди tryEnqueue возвращает false
+// и не трогает значение, при пустой tryDequeue возвращает false.
+// Индексы производителей и потребителей разнесены по разным кеш-линиям
+
+// Один производитель и один потребитель: tryEnqueue вызывается только из
+// одного потока, tryDequeue и tryPeek — только из другого
+class SpscQueue {
+private:
+    static constexpr size_t CACHE_LINE = 64;
+    
+    std::vector<std::string> slots;
+    size_t mask;
+    char slotsPadding[CACHE_LINE];
+    // Индексы растут без ограничения, ячейка — индекс & mask.
+    // Рядом с каждым индексом лежит копия чужого индекса, которую поток
+    // перечитывает, только когда по ней очередь выглядит пустой (полной)
+    std::atomic<size_t> head;
+    size_t cachedTail;
+    char headPadding[CACHE_LINE];
+    std::atomic<size_t> tail;
+    size_t cachedHead;
+    char tailPadding[CACHE_LINE];
+    
+    template<typename Value>
+    bool push(Value&& value);
+
+public:
+    explicit SpscQueue(size_t capacity);
+    
+    // Запрет копирования
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+    
+    // Операции производителя и потребителя
+    bool tryEnqueue(const std::string& value);
+    bool tryEnqueue(std::string&& value);
+    bool tryDequeue(std::string& out);
+    bool tryPeek(std::string& out) const;
+    
+    // Утилиты. Размер при параллельной работе — моментальная оценка
+    size_t getCapacity() const { return slots.size(); }
+    size_t getSize() const;
+    bool isEmpty() const { return getSize() == 0; }
+};
+
+// Много производителей и много потребителей (схема Вьюкова): у каждой
+// ячейки свой номер последовательности, поток занимает позицию одним
+// CAS и публикует ячейку записью номера. Заглянуть в начало очереди
+// (peek) нельзя: значение может в тот же момент забирать другой потребитель
+class MpmcQueue {
+private:
+    static constexpr size_t CACHE_LINE = 64;
+    
+    struct Cell {
+        std::atomic<size_t> sequence;
+        std::string data;
+    };
+    
+    std::unique_ptr<Cell[]> cells;
+    size_t capacity;
+    size_t mask;
+    char cellsPadding[CACHE_LINE];
+    std::atomic<size_t> enqueuePos;
+    char enqueuePadding[CACHE_LINE];
+    std::atomic<size_t> dequeuePos;
+    char dequeuePadding[CACHE_LINE];
+    
+    template<typename Value>
+    bool push(Value&& value);
+
+public:
+    explicit MpmcQueue(size_t capacity);
+    
+    // Запрет копирования
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+    
+    // Основные операции (потокобезопасны)
+    bool tryEnqueue(const std::string& value);
+    bool tryEnqueue(std::string&& value);
+    bool tryDequeue(std::string& out);
+    
+    // Утилиты. Размер при параллельной работе — моментальная оценка
+    size_t getCapacity() const { return capacity; }
+    size_t getSize() const;
+    bool isEmpty() const { return getSize() == 0; }
+};
+
+// Блокирующая обёртка над SpscQueue или MpmcQueue. Операция сначала
+// повторяет попытку (SPIN_COUNT раз подряд, затем YIELD_COUNT раз
+// с уступкой процессора) и только потом засыпает на условной переменной.
+// Мьютекс берётся лишь при засыпании и при пробуждении ждущих, поэтому
+// без ожидания передача проходит без блокировок.
+// Ограничения на число потоков — те же, что у обёрнутой очереди
+template<typename LockFreeQueue>
+class BlockingQueue {
+private:
+    static constexpr int SPIN_COUNT = 64;
+    static constexpr int YIELD_COUNT = 16;
+    
+    LockFreeQueue queue;
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::atomic<int> waitingConsumers;
+    std::atomic<int> waitingProducers;
+    std::atomic<bool> closed;
+    
+    // Значение перемещается только при успешной вставке, поэтому
+    // повторные попытки с тем же rvalue безопасны
+    template<typename Value>
+    bool push(Value&& value, bool wait);
+    void wake(std::atomic<int>& waiting, std::condition_variable& condition);
+
+public:
+    explicit BlockingQueue(size_t capacity)
+        : queue(capacity), waitingConsumers(0), waitingProducers(0), closed(false) {}
+    
+    // Запрет копирования
+    BlockingQueue(const BlockingQueue&) = delete;
+    BlockingQueue& operator=(const BlockingQueue&) = delete;
+    
+    // Ждут места (значения). false — очередь закрыта (и, для dequeue, пуста)
+    bool enqueue(const std::string& value) { return push(value, true); }
+    bool enqueue(std::string&& value) { return push(std::move(value), true); }
+    bool dequeue(std::string& out);
+    
+    // Неблокирующие попытки
+    bool tryEnqueue(const std::string& value) { return push(value, false); }
+    bool tryEnqueue(std::string&& value) { return push(std::move(value), false); }
+    bool tryDequeue(std::string& out);
+    
+    // После закрытия новые значения не принимаются, а ждущие потоки
+    // просыпаются; потребители забирают оставшееся
+    void close();
+    bool isClosed() const { return closed.load(std::memory_order_acquire); }
+    
+    size_t getCapacity() const { return queue.getCapacity(); }
+    size_t getSize() const { return queue.getSize(); }
+    bool isEmpty() const { return queue.isEmpty(); }
+};
+
+template<typename LockFreeQueue>
+constexpr int BlockingQueue<LockFreeQueue>::SPIN_COUNT;
+template<typename LockFreeQueue>
+constexpr int BlockingQueue<LockFreeQueue>::YIELD_COUNT;
+
+template<typename LockFreeQueue>
+void BlockingQueue<LockFreeQueue>::wake(std::atomic<int>& waiting,
+                                        std::condition_variable& condition) {
+    // Барьер в паре с барьером засыпающего потока: либо он увидит
+    // изменение очереди, либо здесь будет виден его счётчик ожидания
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        condition.notify_one();
+    }
+}
+
+template<typename LockFreeQueue>
+template<typename Value>
+bool BlockingQueue<LockFreeQueue>::push(Value&& value, bool wait) {
+    for (int attempt = 0; attempt < SPIN_COUNT + YIELD_COUNT; attempt++) {
+        if (closed.load(std::memory_order_acquire)) {
+            return false;
+        }
+        if (queue.tryEnqueue(std::forward<Value>(value))) {
+            wake(waitingConsumers, notEmpty);
+            return true;
+        }
+        if (!wait) {
+            return false;
+        }
+        if (attempt >= SPIN_COUNT) {
+            std::this_thread::yield();
+        }
+    }
+    
+    std::unique_lock<std::mutex> lock(mutex);
+    waitingProducers.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool pushed = false;
+    notFull.wait(lock, [&] {
+        if (closed.load(std::memory_order_acquire)) {
+            return true;
+        }
+        pushed = queue.tryEnqueue(std::forward<Value>(value));
+        return pushed;
+    });
+    waitingProducers.fetch_sub(1, std::memory_order_relaxed);
+    lock.unlock();
+    
+    if (pushed) {
+        wake(waitingConsumers, notEmpty);
+    }
+    return pushed;
+}
+
+template<typename LockFreeQueue>
+bool BlockingQueue<LockFreeQueue>::tryDequeue(std::string& out) {
+    if (!queue.tryDequeue(out)) {
+        return false;
+    }
+    wake(waitingProducers, notFull);
+    return true;
+}
+
+template<typename LockFreeQueue>
+bool BlockingQueue<LockFreeQueue>::dequeue(std::string& out) {
+    for (int attempt = 0; attempt < SPIN_COUNT + YIELD_COUNT; attempt++) {
+        if (tryDequeue(out)) {
+            return true;
+        }
+        if (closed.load(std::memory_order_acquire)) {
+            break;
+        }
+        if (attempt >= SPIN_COUNT) {
+            std::this_thread::yield();
+        }
+    }
+    
+    std::unique_lock<std::mutex> lock(mutex);
+    waitingConsumers.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool popped = false;
+    notEmpty.wait(lock, [&] {
+        popped = queue.tryDequeue(out);
+        return popped || closed.load(std::memory_order_acquire);
+    });
+    waitingConsumers.fetch_sub(1, std::memory_order_relaxed);
+    lock.unlock();
+    
+    if (popped) {
+        wake(waitingProducers, notFull);
+    }
+    return popped;
+}
+
+template<typename LockFreeQueue>
+void BlockingQueue<LockFreeQueue>::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed.store(true, std::memory_order_release);
+    notEmpty.notify_all();
+    notFull.notify_all();
+}
+
+#endif
\ No newline at end of file
@@ -2,27 +2,92 @@
 #include <iostream>
 #include <fstream>
 #include <stdexcept>
+#include <algorithm>
 
-DoublyList::DoublyList() : head(nullptr), tail(nullptr), size(0) {}
+constexpr int DoublyList::BLOCK_CAPACITY;
+
+DoublyList::DoublyList(NodeAllocation allocation)
+    : DoublyList(StorageMode::Linked, allocation) {}
+
+DoublyList::DoublyList(StorageMode mode, NodeAllocation allocation)
+    : head(nullptr), tail(nullptr), firstBlock(nullptr), lastBlock(nullptr), size(0),
+      storageMode(mode),
+      pool(allocation == NodeAllocation::Pooled
+           ? new NodePool(mode == StorageMode::Unrolled ? sizeof(Block) : sizeof(Node))
+           : nullptr) {}
 
 DoublyList::~DoublyList() {
     clear();
 }
 
 void DoublyList::clear() {
+    // Узлы пула не возвращаются по одному: после деструкторов
+    // все плиты освобождаются разом
     while (head != nullptr) {
         Node* temp = head;
         head = head->next;
-        delete temp;
+        if (pool) {
+            temp->~Node();
+        } else {
+            delete temp;
+        }
+    }
+    while (firstBlock != nullptr) {
+        Block* temp = firstBlock;
+        firstBlock = firstBlock->next;
+        if (pool) {
+            temp->~Block();
+        } else {
+            delete temp;
+        }
+    }
+    lastBlock = nullptr;
+    if (pool) {
+        pool->release();
+    }
+    if (index) {
+        index->clear();
     }
     head = tail = nullptr;
     size = 0;
 }
 
-DoublyList::Node* DoublyList::findNode(const std::string& value) const {
+DoublyList::Node* DoublyList::createNode(const std::string& value) {
+    if (pool) {
+        return pool->create<Node>(value);
+    }
+    return new Node(value);
+}
+
+void DoublyList::destroyNode(Node* node) {
+    if (pool) {
+        pool->destroy(node);
+    } else {
+        delete node;
+    }
+}
+
+DoublyList::Node* DoublyList::findNode(const std::string& value) {
+    if (index) {
+        const IndexEntry* entry = index->find(value);
+        if (entry == nullptr) {
+            return nullptr;
+        }
+        if (entry->node != nullptr) {
+            return entry->node;
+        }
+    }
+    
     Node* current = head;
     while (current != nullptr) {
         if (current->data == value) {
+            // Значение, оставшееся в одном экземпляре, запоминается в индексе
+            if (index) {
+                IndexEntry* entry = index->find(value);
+                if (entry->count == 1) {
+                    entry->node = current;
+                }
+            }
             return current;
         }
         current = current->next;
@@ -30,8 +95,155 @@ DoublyList::Node* DoublyList::findNode(const std::string& value) const {
     return nullptr;
 }
 
+void DoublyList::indexAdd(Node* node) {
+    if (!index) return;
+    
+    IndexEntry* entry = index->find(node->data);
+    if (entry == nullptr) {
+        index->insert(node->data, IndexEntry{node, 1});
+    } else {
+        entry->node = nullptr;
+        entry->count++;
+    }
+}
+
+void DoublyList::indexRemove(Node* node) {
+    if (!index) return;
+    
+    IndexEntry* entry = index->find(node->data);
+    if (entry->count == 1) {
+        index->remove(node->data);
+    } else {
+        // Какое из оставшихся вхождений первое, станет известно при поиске
+        entry->node = nullptr;
+        entry->count--;
+    }
+}
+
+DoublyList::Block* DoublyList::createBlock() {
+    if (pool) {
+        return pool->create<Block>();
+    }
+    return new Block();
+}
+
+void DoublyList::destroyBlock(Block* block) {
+    if (pool) {
+        pool->destroy(block);
+    } else {
+        delete block;
+    }
+}
+
+bool DoublyList::blockLocate(const std::string& value, Block*& block, int& offset) const {
+    for (block = firstBlock; block != nullptr; block = block->next) {
+        for (offset = 0; offset < block->count; offset++) {
+            if (block->items[offset] == value) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void DoublyList::blockInsert(Block* block, int offset, const std::string& value) {
+    if (block == nullptr) {
+        block = firstBlock = lastBlock = createBlock();
+    } else if (block->count == BLOCK_CAPACITY) {
+        Block* next = createBlock();
+        next->prev = block;
+        next->next = block->next;
+        if (block->next != nullptr) {
+            block->next->prev = next;
+        } else {
+            lastBlock = next;
+        }
+        block->next = next;
+        
+        if (next == lastBlock && offset == BLOCK_CAPACITY) {
+            // Дописывание в конец списка: заполненный блок не делится
+            block = next;
+            offset = 0;
+        } else {
+            const int half = BLOCK_CAPACITY / 2;
+            std::move(block->items + half, block->items + BLOCK_CAPACITY, next->items);
+            next->count = BLOCK_CAPACITY - half;
+            block->count = half;
+            if (offset > half) {
+                block = next;
+                offset -= half;
+            }
+        }
+    }
+    
+    std::move_backward(block->items + offset, block->items + block->count,
+                       block->items + block->count + 1);
+    block->items[offset] = value;
+    block->count++;
+    size++;
+}
+
+void DoublyList::blockErase(Block* block, int offset) {
+    std::move(block->items + offset + 1, block->items + block->count, block->items + offset);
+    block->count--;
+    // Освободившаяся ячейка не должна держать память строки
+    std::string().swap(block->items[block->count]);
+    size--;
+    
+    // Блок, заполненный меньше чем наполовину, забирает следующий целиком
+    Block* next = block->next;
+    if (next != nullptr && block->count < BLOCK_CAPACITY / 2 &&
+        block->count + next->count <= BLOCK_CAPACITY) {
+        std::move(next->items, next->items + next->count, block->items + block->count);
+        block->count += next->count;
+        block->next = next->next;
+        if (next->next != nullptr) {
+            next->next->prev = block;
+        } else {
+            lastBlock = block;
+        }
+        destroyBlock(next);
+    }
+    
+    if (block->count == 0) {
+        if (block->prev != nullptr) {
+            block->prev->next = block->next;
+        } else {
+            firstBlock = block->next;
+        }
+        if (block->next != nullptr) {
+            block->next->prev = block->prev;
+        } else {
+            lastBlock = block->prev;
+        }
+        destroyBlock(block);
+    }
+}
+
+void DoublyList::setIndexed(bool enabled) {
+    if (enabled && isUnrolled()) {
+        throw std::logic_error("Value index requires linked storage");
+    }
+    if (!enabled) {
+        index.reset();
+        return;
+    }
+    if (index) return;
+    
+    index.reset(new ValueIndex(16, 0.75, ValueIndex::ResizeMode::Immediate,
+                               ValueIndex::ProbeMode::Grouped));
+    for (Node* current = head; current != nullptr; current = current->next) {
+        indexAdd(current);
+    }
+}
+
 void DoublyList::insertFront(const std::string& value) {
-    Node* newNode = new Node(value);
+    if (isUnrolled()) {
+        blockInsert(firstBlock, 0, value);
+        return;
+    }
+    
+    Node* newNode = createNode(value);
     
     if (head == nullptr) {
         head = tail = newNode;
@@ -40,11 +252,17 @@ void DoublyList::insertFront(const std::string& value) {
         head->prev = newNode;
         head = newNode;
     }
+    indexAdd(newNode);
     size++;
 }
 
 void DoublyList::insertBack(const std::string& value) {
-    Node* newNode = new Node(value);
+    if (isUnrolled()) {
+        blockInsert(lastBlock, lastBlock != nullptr ? lastBlock->count : 0, value);
+        return;
+    }
+    
+    Node* newNode = createNode(value);
     
     if (tail == nullptr) {
         head = tail = newNode;
@@ -53,16 +271,26 @@ void DoublyList::insertBack(const std::string& value) {
         newNode->prev = tail;
         tail = newNode;
     }
+    indexAdd(newNode);
     size++;
 }
 
 void DoublyList::insertBefore(const std::string& target, const std::string& value) {
+    if (isUnrolled()) {
+        Block* block;
+        int offset;
+        if (blockLocate(target, block, offset)) {
+            blockInsert(block, offset, value);
+        }
+        return;
+    }
+    
     Node* targetNode = findNode(target);
     if (targetNode == nullptr) {
         return;  // target не найден
     }
     
-    Node* newNode = new Node(value);
+    Node* newNode = createNode(value);
     
     if (targetNode == head) {
         // Вставка перед головой
@@ -76,16 +304,26 @@ void DoublyList::insertBefore(const std::string& target, const std::string& valu
         targetNode->prev->next = newNode;
         targetNode->prev = newNode;
     }
+    indexAdd(newNode);
     size++;
 }
 
 void DoublyList::insertAfter(const std::string& target, const std::string& value) {
+    if (isUnrolled()) {
+        Block* block;
+        int offset;
+        if (blockLocate(target, block, offset)) {
+            blockInsert(block, offset + 1, value);
+        }
+        return;
+    }
+    
     Node* targetNode = findNode(target);
     if (targetNode == nullptr) {
         return;  // target не найден
     }
     
-    Node* newNode = new Node(value);
+    Node* newNode = createNode(value);
     
     if (targetNode == tail) {
         // Вставка после хвоста
@@ -99,10 +337,18 @@ void DoublyList::insertAfter(const std::string& target, const std::string& value
         targetNode->next->prev = newNode;
         targetNode->next = newNode;
     }
+    indexAdd(newNode);
     size++;
 }
 
 void DoublyList::removeFront() {
+    if (isUnrolled()) {
+        if (firstBlock != nullptr) {
+            blockErase(firstBlock, 0);
+        }
+        return;
+    }
+    
     if (head == nullptr) {
         return;  // Пустой список
     }
@@ -116,11 +362,19 @@ void DoublyList::removeFront() {
         tail = nullptr;  // Список стал пустым
     }
     
-    delete temp;
+    indexRemove(temp);
+    destroyNode(temp);
     size--;
 }
 
 void DoublyList::removeBack() {
+    if (isUnrolled()) {
+        if (lastBlock != nullptr) {
+            blockErase(lastBlock, lastBlock->count - 1);
+        }
+        return;
+    }
+    
     if (tail == nullptr) {
         return;  // Пустой список
     }
@@ -134,11 +388,21 @@ void DoublyList::removeBack() {
         head = nullptr;  // Список стал пустым
     }
     
-    delete temp;
+    indexRemove(temp);
+    destroyNode(temp);
     size--;
 }
 
 void DoublyList::removeValue(const std::string& value) {
+    if (isUnrolled()) {
+        Block* block;
+        int offset;
+        if (blockLocate(value, block, offset)) {
+            blockErase(block, offset);
+        }
+        return;
+    }
+    
     Node* targetNode = findNode(value);
     if (targetNode == nullptr) {
         return;  // Элемент не найден
@@ -152,12 +416,27 @@ void DoublyList::removeValue(const std::string& value) {
         // Удаление из середины
         targetNode->prev->next = targetNode->next;
         targetNode->next->prev = targetNode->prev;
-        delete targetNode;
+        indexRemove(targetNode);
+        destroyNode(targetNode);
         size--;
     }
 }
 
 void DoublyList::removeBefore(const std::string& target) {
+    if (isUnrolled()) {
+        Block* block;
+        int offset;
+        if (!blockLocate(target, block, offset)) {
+            return;  // target не найден
+        }
+        if (offset > 0) {
+            blockErase(block, offset - 1);
+        } else if (block->prev != nullptr) {
+            blockErase(block->prev, block->prev->count - 1);
+        }
+        return;
+    }
+    
     Node* targetNode = findNode(target);
     if (targetNode == nullptr || targetNode->prev == nullptr) {
         return;  // target не найден или перед ним нет элемента
@@ -171,12 +450,27 @@ void DoublyList::removeBefore(const std::string& target) {
         // Удаление из середины
         nodeToRemove->prev->next = targetNode;
         targetNode->prev = nodeToRemove->prev;
-        delete nodeToRemove;
+        indexRemove(nodeToRemove);
+        destroyNode(nodeToRemove);
         size--;
     }
 }
 
 void DoublyList::removeAfter(const std::string& target) {
+    if (isUnrolled()) {
+        Block* block;
+        int offset;
+        if (!blockLocate(target, block, offset)) {
+            return;  // target не найден
+        }
+        if (offset + 1 < block->count) {
+            blockErase(block, offset + 1);
+        } else if (block->next != nullptr) {
+            blockErase(block->next, 0);
+        }
+        return;
+    }
+    
     Node* targetNode = findNode(target);
     if (targetNode == nullptr || targetNode->next == nullptr) {
         return;  // target не найден или после него нет элемента
@@ -190,29 +484,58 @@ void DoublyList::removeAfter(const std::string& target) {
         // Удаление из середины
         targetNode->next = nodeToRemove->next;
         nodeToRemove->next->prev = targetNode;
-        delete nodeToRemove;
+        indexRemove(nodeToRemove);
+        destroyNode(nodeToRemove);
         size--;
     }
 }
 
 bool DoublyList::search(const std::string& value) const {
-    return findNode(value) != nullptr;
+    if (isUnrolled()) {
+        Block* block;
+        int offset;
+        return blockLocate(value, block, offset);
+    }
+    // Индекс хранит все значения списка; поиск только читает его
+    if (index) {
+        return index->contains(value);
+    }
+    for (Node* current = head; current != nullptr; current = current->next) {
+        if (current->data == value) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void DoublyList::printForward() const {
-    Node* current = head;
+    bool first = true;
     std::cout << "[";
-    while (current != nullptr) {
-        std::cout << current->data;
-        if (current->next != nullptr) {
+    forEach([&first](const std::string& value) {
+        if (!first) {
             std::cout << " <-> ";
         }
-        current = current->next;
-    }
+        std::cout << value;
+        first = false;
+    });
     std::cout << "]" << std::endl;
 }
 
 void DoublyList::printBackward() const {
+    if (isUnrolled()) {
+        std::cout << "[";
+        for (const Block* block = lastBlock; block != nullptr; block = block->prev) {
+            for (int i = block->count - 1; i >= 0; i--) {
+                std::cout << block->items[i];
+                if (i > 0 || block->prev != nullptr) {
+                    std::cout << " <-> ";
+                }
+            }
+        }
+        std::cout << "]" << std::endl;
+        return;
+    }
+    
     Node* current = tail;
     std::cout << "[";
     while (current != nullptr) {
@@ -221,7 +544,7 @@ void DoublyList::printBackward() const {
             std::cout << " <-> ";
         }
         current = current->prev;
-    } 
+    }
     std::cout << "]" << std::endl;
 }
 
@@ -233,13 +556,11 @@ void DoublyList::serializeToFile(const std::string& filename) const {
     
     file.write(reinterpret_cast<const char*>(&size), sizeof(size));
     
-    Node* current = head;
-    while (current != nullptr) {
-        int strSize = current->data.size();
+    forEach([&file](const std::string& value) {
+        int strSize = value.size();
         file.write(reinterpret_cast<const char*>(&strSize), sizeof(strSize));
-        file.write(current->data.c_str(), strSize);
-        current = current->next;
-    }
+        file.write(value.c_str(), strSize);
+    });
     
     file.close();
 }
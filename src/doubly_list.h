@@ -2,9 +2,21 @@
 #define DOUBLY_LIST_H
 
 #include <string>
+#include <memory>
+#include "node_pool.h"
+#include "hash_table.h"
 
 class DoublyList {
+public:
+    // Способ хранения: Linked — по узлу на элемент, Unrolled — развёрнутый
+    // список, в узле (блоке) до BLOCK_CAPACITY элементов подряд. Блок
+    // делится пополам при переполнении и сливается со следующим, когда
+    // заполнен меньше чем наполовину
+    enum class StorageMode { Linked, Unrolled };
+
 private:
+    static constexpr int BLOCK_CAPACITY = 16;
+    
     struct Node {
         std::string data;
         Node* prev;
@@ -12,14 +24,56 @@ private:
         Node(const std::string& value) : data(value), prev(nullptr), next(nullptr) {}
     };
     
+    struct Block {
+        Block* prev;
+        Block* next;
+        int count;
+        std::string items[BLOCK_CAPACITY];
+        Block() : prev(nullptr), next(nullptr), count(0) {}
+    };
+    
     Node* head;
     Node* tail;
+    // Блоки режима Unrolled
+    Block* firstBlock;
+    Block* lastBlock;
     int size;
+    StorageMode storageMode;
+    // Пул узлов или блоков (только в режиме NodeAllocation::Pooled)
+    std::unique_ptr<NodePool> pool;
+    
+    // Индекс значение -> узел. Узел известен, только если значение
+    // в списке одно (node == nullptr при повторах: тогда поиск идёт
+    // обходом, как без индекса). Индекс меняют только неконстантные
+    // методы: константные, как и без индекса, можно вызывать из нескольких
+    // потоков одновременно
+    struct IndexEntry {
+        Node* node;
+        int count;
+    };
+    typedef BasicHashTable<std::string, IndexEntry> ValueIndex;
+    std::unique_ptr<ValueIndex> index;
     
-    Node* findNode(const std::string& value) const;
+    Node* createNode(const std::string& value);
+    void destroyNode(Node* node);
+    // Поиск узла для изменяющих операций: попутно запоминает в индексе
+    // найденный узел, поэтому не константный
+    Node* findNode(const std::string& value);
+    void indexAdd(Node* node);
+    void indexRemove(Node* node);
     
+    // Вспомогательные методы режима Unrolled (элемент задаётся блоком
+    // и смещением в нём)
+    bool isUnrolled() const { return storageMode == StorageMode::Unrolled; }
+    Block* createBlock();
+    void destroyBlock(Block* block);
+    bool blockLocate(const std::string& value, Block*& block, int& offset) const;
+    void blockInsert(Block* block, int offset, const std::string& value);
+    void blockErase(Block* block, int offset);
+
 public:
-    DoublyList();
+    explicit DoublyList(NodeAllocation allocation = NodeAllocation::Heap);
+    explicit DoublyList(StorageMode mode, NodeAllocation allocation = NodeAllocation::Heap);
     ~DoublyList();
     
     // Запрет копирования
@@ -37,15 +91,28 @@ public:
     void removeValue(const std::string& value);
     void removeBefore(const std::string& target);
     void removeAfter(const std::string& target);
-     
+    
     // Поиск
     bool search(const std::string& value) const;
     
+    // Вызывает visitor(const std::string&) для элементов от головы к хвосту
+    template<typename Visitor>
+    void forEach(Visitor visitor) const;
+    
+    // Индекс по значениям: поиск, вставка и удаление по значению за O(1)
+    // в среднем (для неповторяющихся значений) ценой хеш-таблицы рядом
+    // со списком и её обновления при каждом изменении. Только для режима
+    // Linked: в режиме Unrolled элементы переезжают между блоками
+    void setIndexed(bool enabled);
+    bool isIndexed() const { return index != nullptr; }
+    
     // Утилиты
     void printForward() const;
     void printBackward() const;
     int getSize() const { return size; }
-    bool isEmpty() const { return head == nullptr; }
+    bool isEmpty() const { return size == 0; }
+    StorageMode getStorageMode() const { return storageMode; }
+    NodeAllocation getAllocation() const { return pool ? NodeAllocation::Pooled : NodeAllocation::Heap; }
     void clear();
     
     // Сериализация
@@ -53,4 +120,20 @@ public:
     void deserializeFromFile(const std::string& filename);
 };
 
+template<typename Visitor>
+void DoublyList::forEach(Visitor visitor) const {
+    if (isUnrolled()) {
+        for (const Block* block = firstBlock; block != nullptr; block = block->next) {
+            for (int i = 0; i < block->count; i++) {
+                visitor(block->items[i]);
+            }
+        }
+        return;
+    }
+    
+    for (const Node* current = head; current != nullptr; current = current->next) {
+        visitor(static_cast<const std::string&>(current->data));
+    }
+}
+
 #endif
\ No newline at end of file
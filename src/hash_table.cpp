@@ -1,282 +1,239 @@
 #include "hash_table.h"
-#include <iostream>
-#include <fstream>
-#include <stdexcept>
-#include <vector>
-#include <iomanip>
+#include <cstring>
+#include <sstream>
 
-HashTable::HashTable(int initialCapacity, double threshold) 
-    : capacity(initialCapacity > 0 ? initialCapacity : 8),
-      size(0),
-      loadFactorThreshold(threshold > 0.1 && threshold < 1.0 ? threshold : 0.75) {
-    
-    table.resize(capacity, nullptr);
-} 
+constexpr double HashTableBase::MAX_TOMBSTONE_DENSITY;
+constexpr int HashTableBase::MIGRATION_BUCKETS_PER_OP;
+constexpr int HashTableBase::PREPARE_SLOTS_PER_OP;
+constexpr size_t HashTableBase::SEARCH_BATCH_WIDTH;
+constexpr int HashTableBase::GROUP_WIDTH;
+constexpr signed char HashTableBase::CTRL_EMPTY;
+constexpr signed char HashTableBase::CTRL_DELETED;
+constexpr uint64_t HashTableBase::HASH_SECRET0;
+constexpr uint64_t HashTableBase::HASH_SECRET1;
+constexpr int HashTableBase::PROBE_HISTOGRAM_SIZE;
 
-HashTable::~HashTable() {
-    clear();
-}
+// Дополнительные константы для хеширования длинных строк
+const uint64_t HASH_SECRET2 = 0x8ebc6af09c88c6e3ULL;
+const uint64_t HASH_SECRET3 = 0x589965cc75374cc3ULL;
 
-int HashTable::hashFunction(int key) const {
-    return std::abs(key) % capacity;
+static uint64_t read64(const unsigned char* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
 }
 
-int HashTable::hashFunction2(int key) const {
-    return 1 + (std::abs(key) % (capacity - 1));
-}
-
-double HashTable::getLoadFactor() const {
-    return static_cast<double>(size) / capacity;
-}
-
-void HashTable::rehash() {
-    int oldCapacity = capacity;
-    capacity *= 2;
-    
-    std::vector<HashNode*> oldTable = std::move(table);
-    table.resize(capacity, nullptr);
-    size = 0;
-    
-    // Перехешируем все элементы
-    for (int i = 0; i < oldCapacity; i++) {
-        HashNode* current = oldTable[i];
-        while (current != nullptr) {
-            HashNode* next = current->next;
-            insert(current->key, current->value);
-            delete current;
-            current = next;
-        }
-    }
+static uint64_t read32(const unsigned char* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
 }
 
-void HashTable::insert(int key, const std::string& value) {
-    if (getLoadFactor() >= loadFactorThreshold) {
-        rehash();
-    }
-    
-    int index = hashFunction(key);
-    int step = hashFunction2(key);
-    int originalIndex = index;
-    int probeCount = 0;
-    
-    // Линейное пробирование для разрешения коллизий
-    while (table[index] != nullptr && table[index]->key != key) {
-        index = (originalIndex + probeCount * step) % capacity;
-        probeCount++;
-        
-        if (probeCount >= capacity) {
-            rehash();
-            insert(key, value);
-            return;
+uint64_t HashTableBase::hashBytes(const void* data, size_t length) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t seed = HASH_SECRET0;
+    uint64_t a, b;
+    
+    if (length <= 16) {
+        if (length >= 4) {
+            // Два перекрывающихся окна по 4 байта с каждого края
+            size_t shift = (length >> 3) << 2;
+            a = (read32(p) << 32) | read32(p + shift);
+            b = (read32(p + length - 4) << 32) | read32(p + length - 4 - shift);
+        } else if (length > 0) {
+            a = (static_cast<uint64_t>(p[0]) << 16) |
+                (static_cast<uint64_t>(p[length >> 1]) << 8) | p[length - 1];
+            b = 0;
+        } else {
+            a = b = 0;
         }
-    }
-    
-    if (table[index] == nullptr) {
-        table[index] = new HashNode(key, value);
-        size++;
     } else {
-        // Обновляем существующий ключ
-        table[index]->value = value;
-    }
-}
-
-std::string HashTable::search(int key) const {
-    int index = hashFunction(key);
-    int step = hashFunction2(key);
-    int originalIndex = index;
-    int probeCount = 0;
-    
-    while (probeCount < capacity) {
-        if (table[index] == nullptr) {
-            return "Not Found";
+        size_t remaining = length;
+        
+        // Длинные строки обрабатываются тремя независимыми цепочками по 16 байт
+        if (remaining > 48) {
+            uint64_t seed1 = seed, seed2 = seed;
+            do {
+                uint64_t x = read64(p) ^ HASH_SECRET1, y = read64(p + 8) ^ seed;
+                multiply128(x, y);
+                seed = x ^ y;
+                x = read64(p + 16) ^ HASH_SECRET2;
+                y = read64(p + 24) ^ seed1;
+                multiply128(x, y);
+                seed1 = x ^ y;
+                x = read64(p + 32) ^ HASH_SECRET3;
+                y = read64(p + 40) ^ seed2;
+                multiply128(x, y);
+                seed2 = x ^ y;
+                p += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= seed1 ^ seed2;
         }
         
-        if (table[index]->key == key) {
-            return table[index]->value;
+        while (remaining > 16) {
+            uint64_t x = read64(p) ^ HASH_SECRET1, y = read64(p + 8) ^ seed;
+            multiply128(x, y);
+            seed = x ^ y;
+            p += 16;
+            remaining -= 16;
         }
         
-        index = (originalIndex + probeCount * step) % capacity;
-        probeCount++;
+        // Последние 16 байт (возможно, перекрываясь с уже обработанными)
+        a = read64(p + remaining - 16);
+        b = read64(p + remaining - 8);
     }
     
-    return "Not Found";
+    a ^= HASH_SECRET1;
+    b ^= seed;
+    multiply128(a, b);
+    a ^= HASH_SECRET0 ^ length;
+    b ^= HASH_SECRET1;
+    multiply128(a, b);
+    return a ^ b;
 }
 
-void HashTable::remove(int key) {
-    int index = hashFunction(key);
-    int step = hashFunction2(key);
-    int originalIndex = index;
-    int probeCount = 0;
-    
-    while (probeCount < capacity) {
-        if (table[index] == nullptr) {
-            return; // Ключ не найден
-        }
-        
-        if (table[index]->key == key) {
-            delete table[index];
-            table[index] = nullptr;
-            size--;
-            
-            // Обработка кластеризации (опционально)
-            // Можно выполнить повторную вставку последующих элементов
-            return;
-        }
-        
-        index = (originalIndex + probeCount * step) % capacity;
-        probeCount++;
+void HashTableBase::Counters::reset() {
+    std::atomic<uint64_t>* scalars[] = {
+        &inserts, &updates, &removes, &removeMisses, &rehashes, &rehashNanos,
+        &maxRehashPauseNanos, &compactions, &compactionNanos
+    };
+    for (std::atomic<uint64_t>* counter : scalars) {
+        counter->store(0, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < PROBE_HISTOGRAM_SIZE; i++) {
+        hitProbes[i].store(0, std::memory_order_relaxed);
+        missProbes[i].store(0, std::memory_order_relaxed);
     }
 }
 
-void HashTable::clear() {
-    for (int i = 0; i < capacity; i++) {
-        HashNode* current = table[i];
-        while (current != nullptr) {
-            HashNode* next = current->next;
-            delete current;
-            current = next;
-        }
-        table[i] = nullptr;
+void HashTableBase::Counters::copyTo(Stats& stats) const {
+    stats.hits = 0;
+    stats.misses = 0;
+    for (int i = 0; i < PROBE_HISTOGRAM_SIZE; i++) {
+        stats.hitProbes[i] = hitProbes[i].load(std::memory_order_relaxed);
+        stats.missProbes[i] = missProbes[i].load(std::memory_order_relaxed);
+        stats.hits += stats.hitProbes[i];
+        stats.misses += stats.missProbes[i];
     }
-    size = 0;
+    stats.inserts = inserts.load(std::memory_order_relaxed);
+    stats.updates = updates.load(std::memory_order_relaxed);
+    stats.removes = removes.load(std::memory_order_relaxed);
+    stats.removeMisses = removeMisses.load(std::memory_order_relaxed);
+    stats.rehashes = rehashes.load(std::memory_order_relaxed);
+    stats.rehashNanos = rehashNanos.load(std::memory_order_relaxed);
+    stats.maxRehashPauseNanos = maxRehashPauseNanos.load(std::memory_order_relaxed);
+    stats.compactions = compactions.load(std::memory_order_relaxed);
+    stats.compactionNanos = compactionNanos.load(std::memory_order_relaxed);
 }
 
-void HashTable::print() const {
-    std::cout << "\nHash Table Contents:" << std::endl;
-    std::cout << "Capacity: " << capacity << ", Size: " << size << std::endl;
-    std::cout << "Load Factor: " << std::fixed << std::setprecision(2) << getLoadFactor() << std::endl;
-    
-    for (int i = 0; i < capacity; i++) {
-        std::cout << "[" << i << "]: ";
-        if (table[i] == nullptr) {
-            std::cout << "empty";
-        } else {
-            HashNode* current = table[i];
-            while (current != nullptr) {
-                std::cout << "{" << current->key << ": '" << current->value << "'}";
-                if (current->next != nullptr) {
-                    std::cout << " -> ";
-                }
-                current = current->next;
-            }
-        }
-        std::cout << std::endl;
+static double averageProbes(const uint64_t* buckets, uint64_t lookups) {
+    if (lookups == 0) {
+        return 0.0;
+    }
+    uint64_t total = 0;
+    for (int i = 0; i < HashTableBase::PROBE_HISTOGRAM_SIZE; i++) {
+        total += buckets[i] * (i + 1);
     }
+    return static_cast<double>(total) / lookups;
 }
 
-void HashTable::printStats() const {
-    int emptyBuckets = 0;
-    int maxChainLength = 0;
-    
-    for (int i = 0; i < capacity; i++) {
-        if (table[i] == nullptr) {
-            emptyBuckets++;
-        } else {
-            int chainLength = 0;
-            HashNode* current = table[i];
-            while (current != nullptr) {
-                chainLength++;
-                current = current->next;
-            }
-            if (chainLength > maxChainLength) {
-                maxChainLength = chainLength;
-            }
-        }
-    }
-    
-    std::cout << "\nHash Table Statistics:" << std::endl;
-    std::cout << "Size: " << size << std::endl;
-    std::cout << "Capacity: " << capacity << std::endl;
-    std::cout << "Load Factor: " << std::fixed << std::setprecision(2) << getLoadFactor() << std::endl;
-    std::cout << "Empty Buckets: " << emptyBuckets << " (" 
-              << (emptyBuckets * 100.0 / capacity) << "%)" << std::endl;
-    std::cout << "Max Chain Length: " << maxChainLength << std::endl;
+double HashTableBase::Stats::averageHitProbes() const {
+    return averageProbes(hitProbes, hits);
 }
 
-void HashTable::serializeToFile(const std::string& filename) const {
-    std::ofstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
-        throw std::runtime_error("Cannot open file for writing");
-    }
-    
-    // Сохраняем параметры таблицы
-    file.write(reinterpret_cast<const char*>(&capacity), sizeof(capacity));
-    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
-    file.write(reinterpret_cast<const char*>(&loadFactorThreshold), sizeof(loadFactorThreshold));
-    
-    // Сохраняем элементы
-    for (int i = 0; i < capacity; i++) {
-        HashNode* current = table[i];
-        int chainLength = 0;
-        
-        // Сначала считаем длину цепочки
-        HashNode* counter = current;
-        while (counter != nullptr) {
-            chainLength++;
-            counter = counter->next;
-        }
-        
-        file.write(reinterpret_cast<const char*>(&chainLength), sizeof(chainLength));
-        
-        // Теперь сохраняем элементы цепочки
-        while (current != nullptr) {
-            file.write(reinterpret_cast<const char*>(&current->key), sizeof(current->key));
-            
-            int strSize = current->value.size();
-            file.write(reinterpret_cast<const char*>(&strSize), sizeof(strSize));
-            file.write(current->value.c_str(), strSize);
-            
-            current = current->next;
-        }
+double HashTableBase::Stats::averageMissProbes() const {
+    return averageProbes(missProbes, misses);
+}
+
+void HashTableBase::Stats::merge(const Stats& other) {
+    size += other.size;
+    capacity += other.capacity;
+    tombstones += other.tombstones;
+    loadFactor = capacity > 0 ? static_cast<double>(size) / capacity : 0.0;
+    migrationInProgress = migrationInProgress || other.migrationInProgress;
+    hits += other.hits;
+    misses += other.misses;
+    for (int i = 0; i < PROBE_HISTOGRAM_SIZE; i++) {
+        hitProbes[i] += other.hitProbes[i];
+        missProbes[i] += other.missProbes[i];
     }
-    
-    file.close();
+    inserts += other.inserts;
+    updates += other.updates;
+    removes += other.removes;
+    removeMisses += other.removeMisses;
+    rehashes += other.rehashes;
+    rehashNanos += other.rehashNanos;
+    maxRehashPauseNanos = std::max(maxRehashPauseNanos, other.maxRehashPauseNanos);
+    compactions += other.compactions;
+    compactionNanos += other.compactionNanos;
 }
 
-void HashTable::deserializeFromFile(const std::string& filename) {
-    std::ifstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
-        throw std::runtime_error("Cannot open file for reading");
+static void appendHistogram(std::ostringstream& out, const uint64_t* buckets, int count) {
+    out << "[";
+    for (int i = 0; i < count; i++) {
+        out << (i > 0 ? "," : "") << buckets[i];
     }
-    
-    clear();
-    
-    // Читаем параметры таблицы
-    int newCapacity, newSize;
-    double newThreshold;
-    
-    file.read(reinterpret_cast<char*>(&newCapacity), sizeof(newCapacity));
-    file.read(reinterpret_cast<char*>(&newSize), sizeof(newSize));
-    file.read(reinterpret_cast<char*>(&newThreshold), sizeof(newThreshold));
-    
-    // Пересоздаем таблицу с новыми параметрами
-    capacity = newCapacity;
-    size = 0;
-    loadFactorThreshold = newThreshold;
-    table.resize(capacity, nullptr);
-    
-    // Читаем элементы
-    for (int i = 0; i < capacity; i++) {
-        int chainLength;
-        file.read(reinterpret_cast<char*>(&chainLength), sizeof(chainLength));
-        
-        HashNode** currentPtr = &table[i];
-        for (int j = 0; j < chainLength; j++) {
-            int key;
-            file.read(reinterpret_cast<char*>(&key), sizeof(key));
-            
-            int strSize;
-            file.read(reinterpret_cast<char*>(&strSize), sizeof(strSize));
-            
-            std::string value(strSize, '\0');
-            file.read(&value[0], strSize);
-            
-            // Создаем новый узел
-            *currentPtr = new HashNode(key, value);
-            currentPtr = &((*currentPtr)->next);
-            size++;
-        }
+    out << "]";
+}
+
+std::string HashTableBase::Stats::toJson() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(4);
+    out << "{\"size\":" << size
+        << ",\"capacity\":" << capacity
+        << ",\"tombstones\":" << tombstones
+        << ",\"loadFactor\":" << loadFactor
+        << ",\"migrationInProgress\":" << (migrationInProgress ? "true" : "false")
+        << ",\"lookups\":{\"hits\":" << hits
+        << ",\"misses\":" << misses
+        << ",\"averageHitProbes\":" << averageHitProbes()
+        << ",\"averageMissProbes\":" << averageMissProbes()
+        << ",\"hitProbes\":";
+    appendHistogram(out, hitProbes, PROBE_HISTOGRAM_SIZE);
+    out << ",\"missProbes\":";
+    appendHistogram(out, missProbes, PROBE_HISTOGRAM_SIZE);
+    out << "},\"inserts\":" << inserts
+        << ",\"updates\":" << updates
+        << ",\"removes\":" << removes
+        << ",\"removeMisses\":" << removeMisses
+        << ",\"rehashes\":" << rehashes
+        << ",\"rehashNanos\":" << rehashNanos
+        << ",\"maxRehashPauseNanos\":" << maxRehashPauseNanos
+        << ",\"compactions\":" << compactions
+        << ",\"compactionNanos\":" << compactionNanos
+        << "}";
+    return out.str();
+}
+
+int HashTableBase::roundCapacity(int requested, ProbeMode probe) {
+    int result = probe == ProbeMode::Grouped ? GROUP_WIDTH : 1;
+    while (result < requested) {
+        result *= 2;
     }
+    return result;
+}
+
+void HashTableBase::writeField(std::ostream& file, int value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void HashTableBase::writeField(std::ostream& file, const std::string& value) {
+    int strSize = value.size();
+    file.write(reinterpret_cast<const char*>(&strSize), sizeof(strSize));
+    file.write(value.c_str(), strSize);
+}
+
+void HashTableBase::readField(std::istream& file, int& value) {
+    file.read(reinterpret_cast<char*>(&value), sizeof(value));
+}
+
+void HashTableBase::readField(std::istream& file, std::string& value) {
+    int strSize;
+    file.read(reinterpret_cast<char*>(&strSize), sizeof(strSize));
     
-    file.close();
-}
\ No newline at end of file
+    value.assign(strSize, '\0');
+    file.read(&value[0], strSize);
+}
+
+template class BasicHashTable<int, std::string>;
\ No newline at end of file
@@ -4,57 +4,1335 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <iomanip>
+#include <utility>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
-class HashTable {
+// Нешаблонная часть хеш-таблицы: режимы работы, перемешивающие
+// хеш-функции и сканирование управляющих байтов. Общая для всех
+// типов ключей и значений
+class HashTableBase {
+public:
+    // Режим роста таблицы: Immediate перехеширует всё за одну вставку,
+    // Incremental переносит ячейки старой таблицы порциями при каждой записи
+    enum class ResizeMode { Immediate, Incremental };
+    
+    // Движок пробирования: DoubleHashing проверяет по одной ячейке,
+    // Grouped сканирует управляющие байты группами по 16 (в стиле Swiss table)
+    // и держит ёмкость степенью двойки
+    enum class ProbeMode { DoubleHashing, Grouped };
+    
+    // Прогресс инкрементального перехеширования. Сначала новая таблица
+    // порциями инициализируется (slotsPrepared), затем в неё порциями
+    // переносятся ячейки старой (bucketsMigrated)
+    struct MigrationStats {
+        bool inProgress;
+        int oldCapacity;
+        int newCapacity;
+        int slotsPrepared;
+        int bucketsMigrated;
+        int elementsRemaining;
+    };
+    
+    // Число интервалов гистограммы длины проб: интервал i считает поиски,
+    // просмотревшие i + 1 ячеек (для группового движка — групп),
+    // последний — все более длинные
+    static constexpr int PROBE_HISTOGRAM_SIZE = 16;
+    
+    // Снимок статистики таблицы. Счётчики накапливаются с создания таблицы
+    // (или с resetStats) и не сбрасываются при clear()
+    struct Stats {
+        int size;
+        int capacity;
+        int tombstones;
+        double loadFactor;
+        bool migrationInProgress;
+        
+        // Поиски (find, search, contains, searchBatch) и длины их проб.
+        // Число попаданий и промахов — суммы гистограмм
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t hitProbes[PROBE_HISTOGRAM_SIZE];
+        uint64_t missProbes[PROBE_HISTOGRAM_SIZE];
+        
+        // Операции записи
+        uint64_t inserts;
+        uint64_t updates;
+        uint64_t removes;
+        uint64_t removeMisses;
+        
+        // Рост и уплотнение. Для инкрементального роста время складывается
+        // из всех порций, а самая долгая пауза — это самая долгая порция
+        uint64_t rehashes;
+        uint64_t rehashNanos;
+        uint64_t maxRehashPauseNanos;
+        uint64_t compactions;
+        uint64_t compactionNanos;
+        
+        // Средние длины проб по гистограмме; последний интервал
+        // считается за PROBE_HISTOGRAM_SIZE проб, так что это оценка снизу
+        double averageHitProbes() const;
+        double averageMissProbes() const;
+        // Сложение статистики нескольких таблиц (например, сегментов)
+        void merge(const Stats& other);
+        std::string toJson() const;
+    };
+    
+    // Перемешивание 64-битного значения (в стиле wyhash): 128-битное
+    // произведение сворачивается в 64 бита, так что каждый бит входа
+    // влияет на все биты результата
+    static uint64_t mixHash(uint64_t value) {
+        uint64_t a = value ^ HASH_SECRET0;
+        uint64_t b = HASH_SECRET1;
+        multiply128(a, b);
+        a ^= HASH_SECRET0;
+        b ^= HASH_SECRET1;
+        multiply128(a, b);
+        return a ^ b;
+    }
+    
+    // Хеш последовательности байтов (упрощённый wyhash)
+    static uint64_t hashBytes(const void* data, size_t length);
+
+protected:
+    // Счётчики статистики. Обновляются парой relaxed-чтение/запись, без
+    // атомарного сложения: на горячем пути это обычные mov без блокировки
+    // шины. Параллельные читатели под общей блокировкой могут изредка
+    // терять инкременты, но не получают гонку данных. Поиск обновляет
+    // ровно один счётчик — интервал гистограммы
+    struct Counters {
+        std::atomic<uint64_t> hitProbes[PROBE_HISTOGRAM_SIZE];
+        std::atomic<uint64_t> missProbes[PROBE_HISTOGRAM_SIZE];
+        std::atomic<uint64_t> inserts;
+        std::atomic<uint64_t> updates;
+        std::atomic<uint64_t> removes;
+        std::atomic<uint64_t> removeMisses;
+        std::atomic<uint64_t> rehashes;
+        std::atomic<uint64_t> rehashNanos;
+        std::atomic<uint64_t> maxRehashPauseNanos;
+        std::atomic<uint64_t> compactions;
+        std::atomic<uint64_t> compactionNanos;
+        
+        Counters() { reset(); }
+        void reset();
+        void copyTo(Stats& stats) const;
+    };
+    
+    static void bump(std::atomic<uint64_t>& counter, uint64_t amount = 1) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+    
+    static void recordLookup(Counters& counters, int probes, bool hit) {
+        int bucket = std::min(std::max(probes, 1), static_cast<int>(PROBE_HISTOGRAM_SIZE)) - 1;
+        bump((hit ? counters.hitProbes : counters.missProbes)[bucket]);
+    }
+    
+    // Учёт паузы на перехеширование или уплотнение, начатой в start
+    static void recordPause(std::atomic<uint64_t>& total, std::atomic<uint64_t>* max,
+                            std::chrono::steady_clock::time_point start) {
+        uint64_t nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        bump(total, nanos);
+        if (max != nullptr && nanos > max->load(std::memory_order_relaxed)) {
+            max->store(nanos, std::memory_order_relaxed);
+        }
+    }
+    
+    // Состояние ячейки открытой адресации.
+    // Deleted — надгробие: ячейка свободна для вставки, но не обрывает
+    // последовательность проб. Pending используется только при уплотнении.
+    enum class SlotState : unsigned char { Empty, Occupied, Deleted, Pending };
+    
+    // Доля надгробий от ёмкости, после которой remove уплотняет таблицу
+    static constexpr double MAX_TOMBSTONE_DENSITY = 0.25;
+    
+    // Сколько ячеек старой таблицы переносится за одну операцию записи
+    static constexpr int MIGRATION_BUCKETS_PER_OP = 16;
+    
+    // Сколько ячеек новой таблицы инициализируется за одну операцию записи.
+    // Подготовка удвоенной таблицы занимает capacity / 32 записей, так что
+    // текущая таблица переполняется сверх порога не больше чем на 1/32
+    // ёмкости, и цепочки проб во время роста остаются короткими
+    static constexpr int PREPARE_SLOTS_PER_OP = 64;
+    
+    // Сколько ключей searchBatch держит "в полёте" между prefetch и разрешением
+    static constexpr size_t SEARCH_BATCH_WIDTH = 16;
+    
+    // Параметры группового пробирования (ProbeMode::Grouped)
+    static constexpr int GROUP_WIDTH = 16;
+    static constexpr signed char CTRL_EMPTY = -128;
+    static constexpr signed char CTRL_DELETED = -2;
+    
+    static constexpr uint64_t HASH_SECRET0 = 0xa0761d6478bd642fULL;
+    static constexpr uint64_t HASH_SECRET1 = 0xe7037ed1a0b428dbULL;
+    
+    // 128-битное произведение a * b: младшая половина в a, старшая в b
+    static void multiply128(uint64_t& a, uint64_t& b) {
+#ifdef __SIZEOF_INT128__
+        unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+        a = static_cast<uint64_t>(r);
+        b = static_cast<uint64_t>(r >> 64);
+#else
+        uint64_t ha = a >> 32, hb = b >> 32, la = a & 0xFFFFFFFFULL, lb = b & 0xFFFFFFFFULL;
+        uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        uint64_t t = rl + (rm0 << 32);
+        uint64_t carry = t < rl;
+        uint64_t lo = t + (rm1 << 32);
+        carry += lo < t;
+        a = lo;
+        b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+    }
+    
+    // Младшие 7 бит хеша идут в тег управляющего байта, остальные выбирают группу
+    static signed char hashTag(uint64_t hash) {
+        return static_cast<signed char>(hash & 0x7F);
+    }
+    
+    // Битовая маска байтов группы, равных value
+    static unsigned matchByte(const signed char* group, signed char value) {
+#ifdef __SSE2__
+        __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(value)));
+#else
+        unsigned mask = 0;
+        for (int i = 0; i < GROUP_WIDTH; i++) {
+            if (group[i] == value) {
+                mask |= 1u << i;
+            }
+        }
+        return mask;
+#endif
+    }
+    
+    // Битовая маска свободных ячеек группы: у пустых ячеек и надгробий
+    // установлен старший бит, у тегов занятых ячеек он сброшен
+    static unsigned matchFree(const signed char* group) {
+#ifdef __SSE2__
+        __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return _mm_movemask_epi8(ctrl);
+#else
+        unsigned mask = 0;
+        for (int i = 0; i < GROUP_WIDTH; i++) {
+            if (group[i] < 0) {
+                mask |= 1u << i;
+            }
+        }
+        return mask;
+#endif
+    }
+    
+    // Ёмкость — степень двойки не меньше запрошенной: на ней шаг двойного
+    // хеширования обходит все ячейки, а групповому движку она нужна
+    // не меньше одной группы
+    static int roundCapacity(int requested, ProbeMode probe);
+    
+    // Начальная ячейка и шаг двойного хеширования: ячейка из младших 32 бит
+    // хеша, шаг из старших (32-битное деление заметно дешевле 64-битного).
+    // Шаг всегда нечётен, а ёмкость — степень двойки (roundCapacity),
+    // поэтому последовательность проб обходит все ячейки. Таблица из одной
+    // ячейки обходится шагом 1
+    static int homeIndex(uint64_t hash, int tableCapacity) {
+        return static_cast<int>(static_cast<uint32_t>(hash) % static_cast<uint32_t>(tableCapacity));
+    }
+    static int probeStep(uint64_t hash, int tableCapacity) {
+        if (tableCapacity < 2) {
+            return 1;
+        }
+        uint32_t high = static_cast<uint32_t>(hash >> 32);
+        return 1 + 2 * static_cast<int>(high % static_cast<uint32_t>(tableCapacity / 2));
+    }
+    // Следующая ячейка последовательности проб (step < tableCapacity)
+    static int nextProbe(int index, int step, int tableCapacity) {
+        index += step;
+        return index >= tableCapacity ? index - tableCapacity : index;
+    }
+    
+    // Результат search() для отсутствующего ключа: метка "Not Found"
+    // для строковых значений, значение по умолчанию для остальных типов
+    static std::string notFoundValue(const std::string*) { return "Not Found"; }
+    template <typename Value>
+    static Value notFoundValue(const Value*) { return Value(); }
+    
+    // Поля двоичного формата сериализации: int пишется как есть,
+    // строка — длиной и байтами
+    static void writeField(std::ostream& file, int value);
+    static void writeField(std::ostream& file, const std::string& value);
+    static void readField(std::istream& file, int& value);
+    static void readField(std::istream& file, std::string& value);
+};
+
+// Хешер по умолчанию: std::hash ключа, усиленный перемешиванием
+// (для целых std::hash — тождественная функция)
+template <typename Key>
+struct DefaultHash {
+    uint64_t operator()(const Key& key) const {
+        return HashTableBase::mixHash(static_cast<uint64_t>(std::hash<Key>()(key)));
+    }
+};
+
+template <>
+struct DefaultHash<std::string> {
+    uint64_t operator()(const std::string& key) const {
+        return HashTableBase::hashBytes(key.data(), key.size());
+    }
+};
+
+// Тождественный хешер для целых ключей: ключ без перемешивания,
+// как в прежней схеме key % capacity. Годится для заранее перемешанных
+// ключей и для тестов, которым нужны предсказуемые коллизии
+struct IdentityHash {
+    template <typename Key>
+    uint64_t operator()(const Key& key) const {
+        return static_cast<uint64_t>(key);
+    }
+};
+
+// Хеш-таблица с открытой адресацией. Хешер — функциональный объект,
+// возвращающий 64-битный хеш ключа; таблица берёт из него и начальную
+// ячейку, и шаг пробирования, и тег управляющего байта
+template <typename Key, typename Value, typename Hash = DefaultHash<Key>>
+class BasicHashTable : public HashTableBase {
 private:
-    // Структура для элемента цепочки
-    struct HashNode {
-        int key;
-        std::string value; 
-        HashNode* next;
-        HashNode(int k, const std::string& v) : key(k), value(v), next(nullptr) {}
+    // Ячейка хранит ключ, состояние и значение прямо в массиве,
+    // поэтому проба не требует перехода по указателю
+    struct Slot {
+        Key key;
+        SlotState state;
+        Value value;
+        Slot() : key(), state(SlotState::Empty), value() {}
     };
     
-    std::vector<HashNode*> table;
+    std::vector<Slot> table;
+    // Управляющие байты для ProbeMode::Grouped: 7-битный тег хеша
+    // занятой ячейки либо признак пустой ячейки или надгробия
+    std::vector<signed char> control;
     int capacity;
     int size;
+    int tombstones;
     double loadFactorThreshold;
+    ResizeMode resizeMode;
+    ProbeMode probeMode;
+    Hash hasher;
     
-    // Хеш-функции
-    int hashFunction(int key) const;
-    int hashFunction2(int key) const;
+    // Новая таблица, которая ещё инициализируется, и старая таблица,
+    // из которой идёт перенос во время инкрементального перехеширования
+    std::vector<Slot> nextTable;
+    std::vector<signed char> nextControl;
+    int nextCapacity;
+    std::vector<Slot> oldTable;
+    std::vector<signed char> oldControl;
+    int oldCapacity;
+    int oldSize;
+    int migrationCursor;
+    std::function<void(const MigrationStats&)> migrationHook;
+    mutable Counters counters;
     
     // Вспомогательные методы
+    void grow();
     void rehash();
+    void compact();
+    void prepareStep(int slots);
+    void startMigration();
+    void migrateStep(int buckets);
+    bool isPreparing() const { return nextCapacity != 0; }
+    bool isMigrating() const { return !oldTable.empty(); }
+    // Поиск ключа; в probes (если передан) накапливается число
+    // просмотренных ячеек (для группового движка — групп)
+    int findIndex(const std::vector<Slot>& slots, const std::vector<signed char>& ctrl,
+                  int slotsCapacity, const Key& key, uint64_t hash, int* probes = nullptr) const;
+    int findIndexGrouped(const std::vector<Slot>& slots, const std::vector<signed char>& ctrl,
+                         int slotsCapacity, const Key& key, uint64_t hash, int* probes) const;
+    int findFreeGrouped(uint64_t hash, bool reuseDeleted) const;
+    int findPlacement(uint64_t hash) const;
+    void markSlot(int index);
+    void placeNew(Key&& key, Value&& value);
+    static void releaseSlot(Slot& slot);
     double getLoadFactor() const;
-    
+
 public:
     // Конструкторы
-    HashTable(int initialCapacity = 8, double threshold = 0.75);
-    ~HashTable();
+    BasicHashTable(int initialCapacity = 8, double threshold = 0.75,
+                   ResizeMode mode = ResizeMode::Immediate,
+                   ProbeMode probe = ProbeMode::DoubleHashing,
+                   const Hash& hash = Hash());
+    ~BasicHashTable();
     
     // Запрет копирования
-    HashTable(const HashTable&) = delete;
-    HashTable& operator=(const HashTable&) = delete;
+    BasicHashTable(const BasicHashTable&) = delete;
+    BasicHashTable& operator=(const BasicHashTable&) = delete;
     
     // Основные операции
-    void insert(int key, const std::string& value);
-    std::string search(int key) const;
-    void remove(int key);
+    void insert(const Key& key, const Value& value);
+    Value search(const Key& key) const;
+    void remove(const Key& key);
+    
+    // Поиск без копирования: указатель на хранимое значение или nullptr.
+    // Указатель действителен до следующего изменения таблицы
+    const Value* find(const Key& key) const;
+    // То же для изменения значения на месте, без повторной вставки
+    Value* find(const Key& key) {
+        return const_cast<Value*>(static_cast<const BasicHashTable*>(this)->find(key));
+    }
+    bool contains(const Key& key) const { return find(key) != nullptr; }
+    
+    // Пакетный поиск: сначала для всех ключей вычисляются хеши и
+    // запрашиваются (prefetch) нужные строки кеша, затем ключи разрешаются.
+    // out[i] получает то же, что вернул бы find(keys[i])
+    void searchBatch(const Key* keys, size_t count, const Value** out) const;
+    
+    // Обход всех элементов (в том числе ещё не перенесённых из старой
+    // таблицы) в порядке ячеек: visitor(key, value)
+    template <typename Visitor>
+    void forEach(Visitor visitor) const;
     
     // Утилиты
     bool isEmpty() const { return size == 0; }
     int getSize() const { return size; }
     int getCapacity() const { return capacity; }
+    ProbeMode getProbeMode() const { return probeMode; }
+    int getTombstones() const { return tombstones; }
     void clear();
     void print() const;
     
     // Статистика
+    Stats getStats() const;
+    void resetStats() { counters.reset(); }
     void printStats() const;
+    // Средняя длина пробы для хранимых ключей: сколько ячеек
+    // (для группового движка — групп) просматривает успешный поиск
+    double getAverageProbeLength() const;
+    MigrationStats getMigrationStats() const;
+    void setMigrationHook(std::function<void(const MigrationStats&)> hook);
     
-    // Сериализация
+    // Сериализация (ключи и значения типов int и std::string)
     void serializeToFile(const std::string& filename) const;
     void deserializeFromFile(const std::string& filename);
 };
 
+// Таблица с целыми ключами и строковыми значениями, используемая по всему проекту
+typedef BasicHashTable<int, std::string> HashTable;
+
+template <typename Key, typename Value, typename Hash>
+BasicHashTable<Key, Value, Hash>::BasicHashTable(int initialCapacity, double threshold,
+                                                 ResizeMode mode, ProbeMode probe,
+                                                 const Hash& hash)
+    : capacity(roundCapacity(initialCapacity > 0 ? initialCapacity : 8, probe)),
+      size(0),
+      tombstones(0),
+      loadFactorThreshold(threshold > 0.1 && threshold < 1.0 ? threshold : 0.75),
+      resizeMode(mode),
+      probeMode(probe),
+      hasher(hash),
+      nextCapacity(0),
+      oldCapacity(0),
+      oldSize(0),
+      migrationCursor(0) {
+    
+    if (probeMode == ProbeMode::Grouped) {
+        control.assign(capacity, CTRL_EMPTY);
+    }
+    table.resize(capacity);
+}
+
+template <typename Key, typename Value, typename Hash>
+BasicHashTable<Key, Value, Hash>::~BasicHashTable() {
+    clear();
+}
+
+template <typename Key, typename Value, typename Hash>
+double BasicHashTable<Key, Value, Hash>::getLoadFactor() const {
+    return static_cast<double>(size) / capacity;
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::releaseSlot(Slot& slot) {
+    // Обмен с пустыми объектами освобождает память строк,
+    // тогда как присваивание сохранило бы их буфер
+    using std::swap;
+    Key emptyKey = Key();
+    Value emptyValue = Value();
+    swap(slot.key, emptyKey);
+    swap(slot.value, emptyValue);
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::grow() {
+    if (resizeMode == ResizeMode::Incremental) {
+        // Предыдущий перенос должен завершиться до начала следующего
+        if (isMigrating()) {
+            migrateStep(oldCapacity - migrationCursor);
+        }
+        
+        // Память под новую таблицу резервируется сразу, но ячейки
+        // создаются порциями: инициализация всей таблицы за одну вставку
+        // дала бы тот же всплеск задержки, что и полное перехеширование
+        bump(counters.rehashes);
+        nextCapacity = capacity * 2;
+        nextTable.reserve(nextCapacity);
+        if (probeMode == ProbeMode::Grouped) {
+            nextControl.reserve(nextCapacity);
+        }
+        prepareStep(PREPARE_SLOTS_PER_OP);
+    } else {
+        rehash();
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::rehash() {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bump(counters.rehashes);
+    int previousCapacity = capacity;
+    capacity *= 2;
+    
+    std::vector<Slot> previous = std::move(table);
+    std::vector<Slot> draining;
+    draining.swap(oldTable);
+    std::vector<signed char>().swap(oldControl);
+    std::vector<Slot>().swap(nextTable);
+    std::vector<signed char>().swap(nextControl);
+    nextCapacity = 0;
+    oldCapacity = 0;
+    oldSize = 0;
+    migrationCursor = 0;
+    
+    table = std::vector<Slot>(capacity);
+    if (probeMode == ProbeMode::Grouped) {
+        control.assign(capacity, CTRL_EMPTY);
+    }
+    size = 0;
+    tombstones = 0;
+    
+    // Перехешируем живые элементы, перемещая их без копирования;
+    // надгробия при этом просто отбрасываются. Незавершённый инкрементальный
+    // перенос доводится до конца здесь же
+    for (int i = 0; i < previousCapacity; i++) {
+        if (previous[i].state == SlotState::Occupied) {
+            placeNew(std::move(previous[i].key), std::move(previous[i].value));
+        }
+    }
+    for (Slot& slot : draining) {
+        if (slot.state == SlotState::Occupied) {
+            placeNew(std::move(slot.key), std::move(slot.value));
+        }
+    }
+    
+    recordPause(counters.rehashNanos, &counters.maxRehashPauseNanos, start);
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::prepareStep(int slots) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    int target = std::min(nextCapacity, static_cast<int>(nextTable.size()) + slots);
+    while (static_cast<int>(nextTable.size()) < target) {
+        nextTable.emplace_back();
+    }
+    if (probeMode == ProbeMode::Grouped) {
+        nextControl.resize(target, CTRL_EMPTY);
+    }
+    
+    if (static_cast<int>(nextTable.size()) == nextCapacity) {
+        startMigration();
+    } else if (migrationHook) {
+        migrationHook(getMigrationStats());
+    }
+    
+    recordPause(counters.rehashNanos, &counters.maxRehashPauseNanos, start);
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::startMigration() {
+    oldTable.swap(table);
+    oldControl.swap(control);
+    oldCapacity = capacity;
+    oldSize = size;
+    migrationCursor = 0;
+    
+    table.swap(nextTable);
+    control.swap(nextControl);
+    capacity = nextCapacity;
+    nextCapacity = 0;
+    tombstones = 0;
+    
+    if (migrationHook) {
+        migrationHook(getMigrationStats());
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::migrateStep(int buckets) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    
+    for (int n = 0; n < buckets && migrationCursor < oldCapacity; n++) {
+        Slot& slot = oldTable[migrationCursor++];
+        if (slot.state != SlotState::Occupied) {
+            continue;
+        }
+        
+        // Забираем элемент из старой ячейки до вставки: если placeNew
+        // перехеширует таблицу целиком, старая таблица будет освобождена.
+        // Перенесённая ячейка становится надгробием, чтобы не разорвать
+        // цепочки проб оставшихся в старой таблице ключей
+        Key key = std::move(slot.key);
+        Value value = std::move(slot.value);
+        slot.state = SlotState::Deleted;
+        if (probeMode == ProbeMode::Grouped) {
+            oldControl[migrationCursor - 1] = CTRL_DELETED;
+        }
+        oldSize--;
+        size--;
+        placeNew(std::move(key), std::move(value));
+        
+        if (!isMigrating()) {
+            recordPause(counters.rehashNanos, &counters.maxRehashPauseNanos, start);
+            return;
+        }
+    }
+    
+    if (migrationCursor >= oldCapacity) {
+        std::vector<Slot>().swap(oldTable);
+        std::vector<signed char>().swap(oldControl);
+        oldCapacity = 0;
+        oldSize = 0;
+        migrationCursor = 0;
+    }
+    
+    if (migrationHook) {
+        migrationHook(getMigrationStats());
+    }
+    
+    recordPause(counters.rehashNanos, &counters.maxRehashPauseNanos, start);
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::placeNew(Key&& key, Value&& value) {
+    // Ключ заведомо отсутствует в таблице: ищем первую свободную ячейку
+    uint64_t hash = hasher(key);
+    int index = -1;
+    if (probeMode == ProbeMode::Grouped) {
+        index = findFreeGrouped(hash, false);
+    } else {
+        int probe = homeIndex(hash, capacity);
+        int step = probeStep(hash, capacity);
+        
+        for (int probeCount = 0; probeCount < capacity; probeCount++) {
+            if (table[probe].state == SlotState::Empty) {
+                index = probe;
+                break;
+            }
+            probe = nextProbe(probe, step, capacity);
+        }
+    }
+    
+    if (index >= 0) {
+        Slot& slot = table[index];
+        slot.key = std::move(key);
+        slot.value = std::move(value);
+        slot.state = SlotState::Occupied;
+        if (probeMode == ProbeMode::Grouped) {
+            control[index] = hashTag(hash);
+        }
+        size++;
+        return;
+    }
+    
+    // Последовательность проб зациклилась без свободной ячейки
+    rehash();
+    placeNew(std::move(key), std::move(value));
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::compact() {
+    // Уплотнение на месте, без выделения памяти: живые элементы помечаются
+    // как ожидающие, надгробия освобождаются, затем каждый ожидающий элемент
+    // переносится в первую подходящую ячейку своей последовательности проб
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bump(counters.compactions);
+    
+    for (Slot& slot : table) {
+        if (slot.state == SlotState::Occupied) {
+            slot.state = SlotState::Pending;
+        } else if (slot.state == SlotState::Deleted) {
+            slot.state = SlotState::Empty;
+        }
+    }
+    tombstones = 0;
+    
+    for (int i = 0; i < capacity; i++) {
+        while (table[i].state == SlotState::Pending) {
+            int target = findPlacement(hasher(table[i].key));
+            
+            if (target < 0) {
+                // Последовательность проб зациклилась — расширяем таблицу
+                for (Slot& slot : table) {
+                    if (slot.state == SlotState::Pending) {
+                        slot.state = SlotState::Occupied;
+                    }
+                }
+                recordPause(counters.compactionNanos, nullptr, start);
+                rehash();
+                return;
+            }
+            
+            // В групповом движке позиция внутри группы не важна
+            if (target == i || (probeMode == ProbeMode::Grouped &&
+                                target / GROUP_WIDTH == i / GROUP_WIDTH)) {
+                table[i].state = SlotState::Occupied;
+                break;
+            }
+            
+            Slot& destination = table[target];
+            if (destination.state == SlotState::Empty) {
+                destination.key = std::move(table[i].key);
+                destination.value = std::move(table[i].value);
+                destination.state = SlotState::Occupied;
+                table[i].state = SlotState::Empty;
+                releaseSlot(table[i]);
+            } else {
+                // Ячейка занята другим ожидающим элементом: меняемся местами
+                // и продолжаем размещать вытесненный элемент
+                using std::swap;
+                swap(destination.key, table[i].key);
+                swap(destination.value, table[i].value);
+                destination.state = SlotState::Occupied;
+            }
+        }
+    }
+    
+    if (probeMode == ProbeMode::Grouped) {
+        for (int i = 0; i < capacity; i++) {
+            markSlot(i);
+        }
+    }
+    
+    recordPause(counters.compactionNanos, nullptr, start);
+}
+
+template <typename Key, typename Value, typename Hash>
+int BasicHashTable<Key, Value, Hash>::findIndex(const std::vector<Slot>& slots,
+                                                const std::vector<signed char>& ctrl,
+                                                int slotsCapacity, const Key& key,
+                                                uint64_t hash, int* probes) const {
+    if (probeMode == ProbeMode::Grouped) {
+        return findIndexGrouped(slots, ctrl, slotsCapacity, key, hash, probes);
+    }
+    
+    int index = homeIndex(hash, slotsCapacity);
+    int step = probeStep(hash, slotsCapacity);
+    
+    for (int probeCount = 0; probeCount < slotsCapacity; probeCount++) {
+        if (probes != nullptr) {
+            (*probes)++;
+        }
+        
+        const Slot& slot = slots[index];
+        if (slot.state == SlotState::Empty) {
+            return -1;
+        }
+        
+        if (slot.state == SlotState::Occupied && slot.key == key) {
+            return index;
+        }
+        
+        index = nextProbe(index, step, slotsCapacity);
+    }
+    
+    return -1;
+}
+
+template <typename Key, typename Value, typename Hash>
+int BasicHashTable<Key, Value, Hash>::findIndexGrouped(const std::vector<Slot>& slots,
+                                                       const std::vector<signed char>& ctrl,
+                                                       int slotsCapacity, const Key& key,
+                                                       uint64_t hash, int* probes) const {
+    signed char tag = hashTag(hash);
+    int groupMask = slotsCapacity / GROUP_WIDTH - 1;
+    int group = static_cast<int>((hash >> 7) & groupMask);
+    
+    // Треугольная последовательность групп обходит все группы,
+    // так как их число — степень двойки
+    for (int probeCount = 0; probeCount <= groupMask; probeCount++) {
+        if (probes != nullptr) {
+            (*probes)++;
+        }
+        
+        const signed char* groupCtrl = &ctrl[group * GROUP_WIDTH];
+        
+        for (unsigned match = matchByte(groupCtrl, tag); match != 0; match &= match - 1) {
+            int index = group * GROUP_WIDTH + __builtin_ctz(match);
+            if (slots[index].key == key) {
+                return index;
+            }
+        }
+        
+        if (matchByte(groupCtrl, CTRL_EMPTY) != 0) {
+            return -1;
+        }
+        
+        group = (group + probeCount + 1) & groupMask;
+    }
+    
+    return -1;
+}
+
+template <typename Key, typename Value, typename Hash>
+int BasicHashTable<Key, Value, Hash>::findFreeGrouped(uint64_t hash, bool reuseDeleted) const {
+    int groupMask = capacity / GROUP_WIDTH - 1;
+    int group = static_cast<int>((hash >> 7) & groupMask);
+    
+    for (int probeCount = 0; probeCount <= groupMask; probeCount++) {
+        const signed char* groupCtrl = &control[group * GROUP_WIDTH];
+        unsigned match = reuseDeleted ? matchFree(groupCtrl) : matchByte(groupCtrl, CTRL_EMPTY);
+        if (match != 0) {
+            return group * GROUP_WIDTH + __builtin_ctz(match);
+        }
+        group = (group + probeCount + 1) & groupMask;
+    }
+    
+    return -1;
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::markSlot(int index) {
+    if (probeMode != ProbeMode::Grouped) {
+        return;
+    }
+    
+    const Slot& slot = table[index];
+    if (slot.state == SlotState::Occupied) {
+        control[index] = hashTag(hasher(slot.key));
+    } else if (slot.state == SlotState::Deleted) {
+        control[index] = CTRL_DELETED;
+    } else {
+        control[index] = CTRL_EMPTY;
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+int BasicHashTable<Key, Value, Hash>::findPlacement(uint64_t hash) const {
+    if (probeMode == ProbeMode::Grouped) {
+        // Управляющие байты во время уплотнения устарели, смотрим на состояния
+        int groupMask = capacity / GROUP_WIDTH - 1;
+        int group = static_cast<int>((hash >> 7) & groupMask);
+        
+        for (int probeCount = 0; probeCount <= groupMask; probeCount++) {
+            for (int i = 0; i < GROUP_WIDTH; i++) {
+                SlotState state = table[group * GROUP_WIDTH + i].state;
+                if (state == SlotState::Empty || state == SlotState::Pending) {
+                    return group * GROUP_WIDTH + i;
+                }
+            }
+            group = (group + probeCount + 1) & groupMask;
+        }
+        return -1;
+    }
+    
+    int index = homeIndex(hash, capacity);
+    int step = probeStep(hash, capacity);
+    
+    for (int probeCount = 0; probeCount < capacity; probeCount++) {
+        SlotState state = table[index].state;
+        if (state == SlotState::Empty || state == SlotState::Pending) {
+            return index;
+        }
+        index = nextProbe(index, step, capacity);
+    }
+    
+    return -1;
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::insert(const Key& key, const Value& value) {
+    if (isMigrating()) {
+        migrateStep(MIGRATION_BUCKETS_PER_OP);
+    } else if (isPreparing()) {
+        // Пока новая таблица готовится, текущая заполняется сверх порога;
+        // если места не осталось совсем, доводим подготовку до конца
+        if (size + tombstones + 1 >= capacity) {
+            prepareStep(nextCapacity);
+        } else {
+            prepareStep(PREPARE_SLOTS_PER_OP);
+        }
+    }
+    
+    // Надгробия занимают ячейки наравне с живыми элементами. Если таблица
+    // заполнена в основном ими, уплотняем её вместо удвоения ёмкости
+    if (!isPreparing() &&
+        static_cast<double>(size + tombstones) / capacity >= loadFactorThreshold) {
+        if (getLoadFactor() < loadFactorThreshold / 2) {
+            compact();
+        } else {
+            grow();
+        }
+    }
+    
+    uint64_t hash = hasher(key);
+    
+    // Ключ, ещё не перенесённый из старой таблицы, обновляем на месте
+    if (isMigrating()) {
+        int oldIndex = findIndex(oldTable, oldControl, oldCapacity, key, hash);
+        if (oldIndex >= 0) {
+            oldTable[oldIndex].value = value;
+            bump(counters.updates);
+            return;
+        }
+    }
+    
+    int freeIndex = -1;
+    
+    if (probeMode == ProbeMode::Grouped) {
+        int index = findIndexGrouped(table, control, capacity, key, hash, nullptr);
+        if (index >= 0) {
+            table[index].value = value;
+            bump(counters.updates);
+            return;
+        }
+        freeIndex = findFreeGrouped(hash, true);
+    } else {
+        int index = homeIndex(hash, capacity);
+        int step = probeStep(hash, capacity);
+        
+        // Двойное хеширование для разрешения коллизий. Поиск продолжается
+        // за надгробиями, чтобы не создать дубликат ключа
+        for (int probeCount = 0; probeCount < capacity; probeCount++) {
+            Slot& slot = table[index];
+            if (slot.state == SlotState::Empty) {
+                if (freeIndex < 0) {
+                    freeIndex = index;
+                }
+                break;
+            }
+            
+            if (slot.state == SlotState::Deleted) {
+                if (freeIndex < 0) {
+                    freeIndex = index;
+                }
+            } else if (slot.key == key) {
+                // Обновляем существующий ключ
+                slot.value = value;
+                bump(counters.updates);
+                return;
+            }
+            
+            index = nextProbe(index, step, capacity);
+        }
+    }
+    
+    if (freeIndex < 0) {
+        rehash();
+        insert(key, value);
+        return;
+    }
+    
+    Slot& slot = table[freeIndex];
+    if (slot.state == SlotState::Deleted) {
+        tombstones--;
+    }
+    slot.key = key;
+    slot.value = value;
+    slot.state = SlotState::Occupied;
+    if (probeMode == ProbeMode::Grouped) {
+        control[freeIndex] = hashTag(hash);
+    }
+    size++;
+    bump(counters.inserts);
+}
+
+template <typename Key, typename Value, typename Hash>
+const Value* BasicHashTable<Key, Value, Hash>::find(const Key& key) const {
+    // Поиск не переносит ячейки: он лишь заглядывает в обе таблицы,
+    // поэтому остаётся константным и безопасным для параллельного чтения
+    uint64_t hash = hasher(key);
+    int probes = 0;
+    int index = findIndex(table, control, capacity, key, hash, &probes);
+    if (index >= 0) {
+        recordLookup(counters, probes, true);
+        return &table[index].value;
+    }
+    
+    if (isMigrating()) {
+        index = findIndex(oldTable, oldControl, oldCapacity, key, hash, &probes);
+        if (index >= 0) {
+            recordLookup(counters, probes, true);
+            return &oldTable[index].value;
+        }
+    }
+    
+    recordLookup(counters, probes, false);
+    return nullptr;
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::searchBatch(const Key* keys, size_t count,
+                                                   const Value** out) const {
+    uint64_t hashes[SEARCH_BATCH_WIDTH];
+    size_t homes[SEARCH_BATCH_WIDTH];
+    
+    for (size_t start = 0; start < count; start += SEARCH_BATCH_WIDTH) {
+        size_t end = std::min(count, start + SEARCH_BATCH_WIDTH);
+        
+        // Проход 1: хеши всех ключей и prefetch первой ячейки
+        // (для группового движка — группы управляющих байтов)
+        for (size_t i = start; i < end; i++) {
+            uint64_t hash = hasher(keys[i]);
+            hashes[i - start] = hash;
+            if (probeMode == ProbeMode::Grouped) {
+                int groupMask = capacity / GROUP_WIDTH - 1;
+                size_t group = (hash >> 7) & groupMask;
+                homes[i - start] = group * GROUP_WIDTH;
+                __builtin_prefetch(&control[homes[i - start]]);
+            } else {
+                homes[i - start] = homeIndex(hash, capacity);
+                __builtin_prefetch(&table[homes[i - start]]);
+            }
+        }
+        
+        // Проход 2 (групповой движок): управляющие байты уже в кеше,
+        // запрашиваем ячейку первого совпавшего тега
+        if (probeMode == ProbeMode::Grouped) {
+            for (size_t i = start; i < end; i++) {
+                unsigned match = matchByte(&control[homes[i - start]], hashTag(hashes[i - start]));
+                if (match != 0) {
+                    __builtin_prefetch(&table[homes[i - start] + __builtin_ctz(match)]);
+                }
+            }
+        }
+        
+        // Проход 3: обычный поиск по уже прогретым строкам кеша
+        for (size_t i = start; i < end; i++) {
+            const Key& key = keys[i];
+            int probes = 0;
+            int index = findIndex(table, control, capacity, key, hashes[i - start], &probes);
+            if (index >= 0) {
+                out[i] = &table[index].value;
+            } else if (isMigrating() &&
+                       (index = findIndex(oldTable, oldControl, oldCapacity, key,
+                                          hashes[i - start], &probes)) >= 0) {
+                out[i] = &oldTable[index].value;
+            } else {
+                out[i] = nullptr;
+            }
+            recordLookup(counters, probes, out[i] != nullptr);
+        }
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+template <typename Visitor>
+void BasicHashTable<Key, Value, Hash>::forEach(Visitor visitor) const {
+    for (const Slot& slot : table) {
+        if (slot.state == SlotState::Occupied) {
+            visitor(slot.key, slot.value);
+        }
+    }
+    for (int i = migrationCursor; i < oldCapacity; i++) {
+        if (oldTable[i].state == SlotState::Occupied) {
+            visitor(oldTable[i].key, oldTable[i].value);
+        }
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+Value BasicHashTable<Key, Value, Hash>::search(const Key& key) const {
+    const Value* value = find(key);
+    return value != nullptr ? *value : notFoundValue(static_cast<const Value*>(nullptr));
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::remove(const Key& key) {
+    if (isPreparing()) {
+        prepareStep(PREPARE_SLOTS_PER_OP);
+    }
+    
+    uint64_t hash = hasher(key);
+    
+    if (isMigrating()) {
+        migrateStep(MIGRATION_BUCKETS_PER_OP);
+        
+        int oldIndex = isMigrating() ? findIndex(oldTable, oldControl, oldCapacity, key, hash) : -1;
+        if (oldIndex >= 0) {
+            // Старая таблица только опустошается, надгробие в ней не мешает
+            Slot& slot = oldTable[oldIndex];
+            slot.state = SlotState::Deleted;
+            if (probeMode == ProbeMode::Grouped) {
+                oldControl[oldIndex] = CTRL_DELETED;
+            }
+            releaseSlot(slot);
+            oldSize--;
+            size--;
+            bump(counters.removes);
+            return;
+        }
+    }
+    
+    int index = findIndex(table, control, capacity, key, hash);
+    if (index < 0) {
+        bump(counters.removeMisses);
+        return; // Ключ не найден
+    }
+    
+    // Оставляем надгробие, чтобы не разорвать цепочку проб
+    Slot& slot = table[index];
+    slot.state = SlotState::Deleted;
+    markSlot(index);
+    releaseSlot(slot);
+    size--;
+    tombstones++;
+    bump(counters.removes);
+    
+    if (tombstones > capacity * MAX_TOMBSTONE_DENSITY) {
+        compact();
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::clear() {
+    table.assign(capacity, Slot());
+    if (probeMode == ProbeMode::Grouped) {
+        control.assign(capacity, CTRL_EMPTY);
+    }
+    size = 0;
+    tombstones = 0;
+    
+    std::vector<Slot>().swap(nextTable);
+    std::vector<signed char>().swap(nextControl);
+    nextCapacity = 0;
+    std::vector<Slot>().swap(oldTable);
+    std::vector<signed char>().swap(oldControl);
+    oldCapacity = 0;
+    oldSize = 0;
+    migrationCursor = 0;
+}
+
+template <typename Key, typename Value, typename Hash>
+HashTableBase::MigrationStats BasicHashTable<Key, Value, Hash>::getMigrationStats() const {
+    MigrationStats stats;
+    stats.inProgress = isPreparing() || isMigrating();
+    if (isPreparing()) {
+        stats.oldCapacity = capacity;
+        stats.newCapacity = nextCapacity;
+        stats.slotsPrepared = nextTable.size();
+        stats.bucketsMigrated = 0;
+        stats.elementsRemaining = size;
+    } else {
+        stats.oldCapacity = oldCapacity;
+        stats.newCapacity = capacity;
+        stats.slotsPrepared = isMigrating() ? capacity : 0;
+        stats.bucketsMigrated = migrationCursor;
+        stats.elementsRemaining = oldSize;
+    }
+    return stats;
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::setMigrationHook(std::function<void(const MigrationStats&)> hook) {
+    migrationHook = std::move(hook);
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::print() const {
+    std::cout << "\nHash Table Contents:" << std::endl;
+    std::cout << "Capacity: " << capacity << ", Size: " << size << std::endl;
+    std::cout << "Load Factor: " << std::fixed << std::setprecision(2) << getLoadFactor() << std::endl;
+    
+    for (int i = 0; i < capacity; i++) {
+        std::cout << "[" << i << "]: ";
+        if (table[i].state == SlotState::Empty) {
+            std::cout << "empty";
+        } else if (table[i].state == SlotState::Deleted) {
+            std::cout << "deleted";
+        } else {
+            std::cout << "{" << table[i].key << ": '" << table[i].value << "'}";
+        }
+        std::cout << std::endl;
+    }
+    
+    if (isMigrating()) {
+        std::cout << "Migrating from capacity " << oldCapacity << ": "
+                  << migrationCursor << "/" << oldCapacity << " buckets moved" << std::endl;
+        for (int i = migrationCursor; i < oldCapacity; i++) {
+            if (oldTable[i].state == SlotState::Occupied) {
+                std::cout << "old[" << i << "]: {" << oldTable[i].key << ": '"
+                          << oldTable[i].value << "'}" << std::endl;
+            }
+        }
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+double BasicHashTable<Key, Value, Hash>::getAverageProbeLength() const {
+    long long totalProbes = 0;
+    int keys = 0;
+    
+    for (int i = 0; i < capacity; i++) {
+        if (table[i].state == SlotState::Occupied) {
+            int probes = 0;
+            findIndex(table, control, capacity, table[i].key, hasher(table[i].key), &probes);
+            totalProbes += probes;
+            keys++;
+        }
+    }
+    for (int i = migrationCursor; i < oldCapacity; i++) {
+        if (oldTable[i].state == SlotState::Occupied) {
+            // Поиск сначала безуспешно проходит новую таблицу
+            int probes = 0;
+            uint64_t hash = hasher(oldTable[i].key);
+            findIndex(table, control, capacity, oldTable[i].key, hash, &probes);
+            findIndex(oldTable, oldControl, oldCapacity, oldTable[i].key, hash, &probes);
+            totalProbes += probes;
+            keys++;
+        }
+    }
+    
+    return keys > 0 ? static_cast<double>(totalProbes) / keys : 0.0;
+}
+
+template <typename Key, typename Value, typename Hash>
+HashTableBase::Stats BasicHashTable<Key, Value, Hash>::getStats() const {
+    Stats stats;
+    stats.size = size;
+    stats.capacity = capacity;
+    stats.tombstones = tombstones;
+    stats.loadFactor = getLoadFactor();
+    stats.migrationInProgress = isPreparing() || isMigrating();
+    counters.copyTo(stats);
+    return stats;
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::printStats() const {
+    int emptyBuckets = 0;
+    for (int i = 0; i < capacity; i++) {
+        if (table[i].state == SlotState::Empty) {
+            emptyBuckets++;
+        }
+    }
+    
+    // Самая длинная проба среди наблюдавшихся поисков (по гистограмме)
+    Stats stats = getStats();
+    int maxProbeBucket = 0;
+    for (int i = 0; i < PROBE_HISTOGRAM_SIZE; i++) {
+        if (stats.hitProbes[i] != 0 || stats.missProbes[i] != 0) {
+            maxProbeBucket = i + 1;
+        }
+    }
+    
+    std::cout << "\nHash Table Statistics:" << std::endl;
+    std::cout << "Size: " << size << std::endl;
+    std::cout << "Capacity: " << capacity << std::endl;
+    std::cout << "Load Factor: " << std::fixed << std::setprecision(2) << getLoadFactor() << std::endl;
+    std::cout << "Empty Buckets: " << emptyBuckets << " ("
+              << (emptyBuckets * 100.0 / capacity) << "%)" << std::endl;
+    std::cout << "Tombstones: " << tombstones << std::endl;
+    std::cout << "Average Probe Length: " << getAverageProbeLength() << std::endl;
+    std::cout << "Lookups: " << stats.hits << " hits (avg " << stats.averageHitProbes()
+              << " probes), " << stats.misses << " misses (avg " << stats.averageMissProbes()
+              << " probes)" << std::endl;
+    std::cout << "Max Probe Length: " << maxProbeBucket
+              << (maxProbeBucket == PROBE_HISTOGRAM_SIZE ? "+" : "") << std::endl;
+    std::cout << "Rehashes: " << stats.rehashes << " (" << stats.rehashNanos / 1000
+              << " us, max pause " << stats.maxRehashPauseNanos / 1000 << " us)" << std::endl;
+    std::cout << "Compactions: " << stats.compactions << " (" << stats.compactionNanos / 1000
+              << " us)" << std::endl;
+    if (isMigrating()) {
+        std::cout << "Migration: " << migrationCursor << "/" << oldCapacity
+                  << " buckets, " << oldSize << " elements remaining" << std::endl;
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::serializeToFile(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for writing");
+    }
+    
+    // Сохраняем параметры таблицы
+    file.write(reinterpret_cast<const char*>(&capacity), sizeof(capacity));
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    file.write(reinterpret_cast<const char*>(&loadFactorThreshold), sizeof(loadFactorThreshold));
+    
+    // Сохраняем элементы в формате "цепочек": запись i содержит элемент
+    // ячейки i и, во время переноса, ещё не перенесённый элемент old[i]
+    for (int i = 0; i < capacity; i++) {
+        const Slot* entries[2];
+        int chainLength = 0;
+        
+        if (table[i].state == SlotState::Occupied) {
+            entries[chainLength++] = &table[i];
+        }
+        if (i < oldCapacity && oldTable[i].state == SlotState::Occupied) {
+            entries[chainLength++] = &oldTable[i];
+        }
+        
+        file.write(reinterpret_cast<const char*>(&chainLength), sizeof(chainLength));
+        
+        for (int j = 0; j < chainLength; j++) {
+            writeField(file, entries[j]->key);
+            writeField(file, entries[j]->value);
+        }
+    }
+    
+    file.close();
+}
+
+template <typename Key, typename Value, typename Hash>
+void BasicHashTable<Key, Value, Hash>::deserializeFromFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for reading");
+    }
+    
+    clear();
+    
+    // Читаем параметры таблицы
+    int newCapacity, newSize;
+    double newThreshold;
+    
+    file.read(reinterpret_cast<char*>(&newCapacity), sizeof(newCapacity));
+    file.read(reinterpret_cast<char*>(&newSize), sizeof(newSize));
+    file.read(reinterpret_cast<char*>(&newThreshold), sizeof(newThreshold));
+    
+    // Пересоздаем таблицу с новыми параметрами
+    capacity = roundCapacity(newCapacity, probeMode);
+    size = 0;
+    tombstones = 0;
+    loadFactorThreshold = newThreshold;
+    table.assign(capacity, Slot());
+    if (probeMode == ProbeMode::Grouped) {
+        control.assign(capacity, CTRL_EMPTY);
+    }
+    
+    // Читаем элементы, сразу перемещая их в ячейки
+    for (int i = 0; i < newCapacity; i++) {
+        int chainLength;
+        file.read(reinterpret_cast<char*>(&chainLength), sizeof(chainLength));
+        
+        for (int j = 0; j < chainLength; j++) {
+            Key key;
+            Value value;
+            readField(file, key);
+            readField(file, value);
+            
+            placeNew(std::move(key), std::move(value));
+        }
+    }
+    
+    file.close();
+}
+
+// Основная специализация собирается один раз, в hash_table.cpp
+extern template class BasicHashTable<int, std::string>;
+
 #endif
\ No newline at end of file
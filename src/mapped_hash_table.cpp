@@ -0,0 +1,238 @@
+#include "mapped_hash_table.h"
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// "L3HS" и версия формата снимка
+const uint32_t SNAPSHOT_MAGIC = 0x5348334C;
+const uint32_t SNAPSHOT_VERSION = 1;
+
+// Признак пустой ячейки снимка
+const uint64_t EMPTY_OFFSET = UINT64_MAX;
+
+// Ёмкость снимка — степень двойки не меньше удвоенного размера:
+// при заполнении не более чем наполовину линейное пробирование
+// по 16-байтовым ячейкам остаётся в пределах одной-двух строк кеша
+const uint64_t MIN_SNAPSHOT_CAPACITY = 16;
+
+static uint64_t snapshotHash(int key) {
+    return DefaultHash<int>()(key);
+}
+
+MappedHashTable::MappedHashTable(const std::string& filename,
+                                 HashTable::ResizeMode mode, HashTable::ProbeMode probe)
+    : image(nullptr),
+      imageSize(0),
+      header(nullptr),
+      slots(nullptr),
+      blob(nullptr),
+      resizeMode(mode),
+      probeMode(probe) {
+    
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open snapshot for reading: " + filename);
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SnapshotHeader)) {
+        close(fd);
+        throw std::runtime_error("Invalid snapshot file: " + filename);
+    }
+    
+    // Частное отображение: страницы только читаются и общие с кешем страниц
+    imageSize = info.st_size;
+    void* mapping = mmap(nullptr, imageSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map snapshot: " + filename);
+    }
+    image = static_cast<const char*>(mapping);
+    
+    // Проверяется только заголовок: ячейки не разбираются при загрузке
+    header = reinterpret_cast<const SnapshotHeader*>(image);
+    uint64_t capacity = header->capacity;
+    bool valid = header->magic == SNAPSHOT_MAGIC &&
+                 header->version == SNAPSHOT_VERSION &&
+                 capacity >= MIN_SNAPSHOT_CAPACITY &&
+                 (capacity & (capacity - 1)) == 0 &&
+                 header->size < capacity &&
+                 capacity <= (imageSize - sizeof(SnapshotHeader)) / sizeof(SnapshotSlot) &&
+                 header->blobOffset == sizeof(SnapshotHeader) + capacity * sizeof(SnapshotSlot) &&
+                 header->blobOffset + header->blobSize == imageSize;
+    if (!valid) {
+        unmap();
+        throw std::runtime_error("Invalid snapshot file: " + filename);
+    }
+    
+    slots = reinterpret_cast<const SnapshotSlot*>(image + sizeof(SnapshotHeader));
+    blob = image + header->blobOffset;
+}
+
+MappedHashTable::~MappedHashTable() {
+    unmap();
+}
+
+void MappedHashTable::unmap() {
+    if (image != nullptr) {
+        munmap(const_cast<char*>(image), imageSize);
+    }
+    image = nullptr;
+    imageSize = 0;
+    header = nullptr;
+    slots = nullptr;
+    blob = nullptr;
+}
+
+void MappedHashTable::writeSnapshot(const HashTable& source, const std::string& filename) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open snapshot for writing: " + filename);
+    }
+    
+    uint64_t capacity = MIN_SNAPSHOT_CAPACITY;
+    while (capacity < static_cast<uint64_t>(source.getSize()) * 2) {
+        capacity *= 2;
+    }
+    
+    // Раскладываем ключи линейным пробированием, значения идут в область
+    // байтов в порядке обхода
+    SnapshotSlot emptySlot = {0, 0, EMPTY_OFFSET};
+    std::vector<SnapshotSlot> snapshotSlots(capacity, emptySlot);
+    std::vector<const std::string*> values;
+    values.reserve(source.getSize());
+    uint64_t blobSize = 0;
+    
+    source.forEach([&](int key, const std::string& value) {
+        uint64_t index = snapshotHash(key) & (capacity - 1);
+        while (snapshotSlots[index].offset != EMPTY_OFFSET) {
+            index = (index + 1) & (capacity - 1);
+        }
+        snapshotSlots[index].key = key;
+        snapshotSlots[index].length = value.size();
+        snapshotSlots[index].offset = blobSize;
+        blobSize += value.size();
+        values.push_back(&value);
+    });
+    
+    SnapshotHeader header;
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.capacity = capacity;
+    header.size = values.size();
+    header.blobOffset = sizeof(SnapshotHeader) + capacity * sizeof(SnapshotSlot);
+    header.blobSize = blobSize;
+    
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(snapshotSlots.data()), capacity * sizeof(SnapshotSlot));
+    for (const std::string* value : values) {
+        file.write(value->data(), value->size());
+    }
+    
+    if (!file) {
+        throw std::runtime_error("Cannot write snapshot: " + filename);
+    }
+    file.close();
+}
+
+const MappedHashTable::SnapshotSlot* MappedHashTable::findSlot(int key) const {
+    uint64_t mask = header->capacity - 1;
+    uint64_t index = snapshotHash(key) & mask;
+    
+    // Снимок заполнен не более чем наполовину, пустая ячейка найдётся
+    for (uint64_t probeCount = 0; probeCount <= mask; probeCount++) {
+        const SnapshotSlot& slot = slots[index];
+        if (slot.offset == EMPTY_OFFSET) {
+            return nullptr;
+        }
+        if (slot.key == key) {
+            return &slot;
+        }
+        index = (index + 1) & mask;
+    }
+    
+    return nullptr;
+}
+
+const char* MappedHashTable::valueOf(const SnapshotSlot& slot) const {
+    // Границы проверяются при обращении, а не разбором всего файла при загрузке
+    if (slot.offset > header->blobSize || slot.length > header->blobSize - slot.offset) {
+        throw std::runtime_error("Corrupted snapshot");
+    }
+    return blob + slot.offset;
+}
+
+bool MappedHashTable::find(int key, const char*& data, size_t& length) const {
+    if (!isMapped()) {
+        const std::string* value = table->find(key);
+        if (value == nullptr) {
+            return false;
+        }
+        data = value->data();
+        length = value->size();
+        return true;
+    }
+    
+    const SnapshotSlot* slot = findSlot(key);
+    if (slot == nullptr) {
+        return false;
+    }
+    data = valueOf(*slot);
+    length = slot->length;
+    return true;
+}
+
+bool MappedHashTable::contains(int key) const {
+    if (!isMapped()) {
+        return table->contains(key);
+    }
+    return findSlot(key) != nullptr;
+}
+
+std::string MappedHashTable::search(int key) const {
+    const char* data;
+    size_t length;
+    if (!find(key, data, length)) {
+        return "Not Found";
+    }
+    return std::string(data, length);
+}
+
+void MappedHashTable::materialize() {
+    if (!isMapped()) {
+        return;
+    }
+    
+    // Ёмкость с запасом под порог 0.75, чтобы копирование не перехешировало
+    // таблицу; конструктор округлит её вверх до степени двойки
+    int size = header->size;
+    std::unique_ptr<HashTable> copy(new HashTable(size + size / 2 + 8, 0.75, resizeMode, probeMode));
+    
+    for (uint64_t i = 0; i < header->capacity; i++) {
+        const SnapshotSlot& slot = slots[i];
+        if (slot.offset != EMPTY_OFFSET) {
+            copy->insert(slot.key, std::string(valueOf(slot), slot.length));
+        }
+    }
+    
+    table = std::move(copy);
+    unmap();
+}
+
+void MappedHashTable::insert(int key, const std::string& value) {
+    materialize();
+    table->insert(key, value);
+}
+
+void MappedHashTable::remove(int key) {
+    materialize();
+    table->remove(key);
+}
+
+int MappedHashTable::getSize() const {
+    return isMapped() ? static_cast<int>(header->size) : table->getSize();
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef MAPPED_HASH_TABLE_H
+#define MAPPED_HASH_TABLE_H
+
+#include <string>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include "hash_table.h"
+
+// Хеш-таблица, загружаемая из снимка отображением файла в память (mmap).
+// Снимок — это готовый массив ячеек фиксированного размера и следом байты
+// значений, поэтому загрузка ничего не разбирает и не выделяет: поиск идёт
+// прямо по отображённому образу, а страницы подгружаются по мере обращения.
+// Первое изменение копирует образ в обычную HashTable (копирование при
+// записи), и дальше все операции работают с ней.
+// Снимок читается на машине с тем же порядком байтов, что и при записи
+class MappedHashTable {
+private:
+    // Заголовок снимка
+    struct SnapshotHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t capacity;
+        uint64_t size;
+        uint64_t blobOffset;
+        uint64_t blobSize;
+    };
+    
+    // Ячейка снимка: ключ и положение значения в области байтов.
+    // Пустая ячейка отмечена offset == EMPTY_OFFSET
+    struct SnapshotSlot {
+        int32_t key;
+        uint32_t length;
+        uint64_t offset;
+    };
+    
+    // Отображённый образ (nullptr после материализации)
+    const char* image;
+    size_t imageSize;
+    const SnapshotHeader* header;
+    const SnapshotSlot* slots;
+    const char* blob;
+    
+    // Таблица, в которую образ копируется при первом изменении
+    std::unique_ptr<HashTable> table;
+    HashTable::ResizeMode resizeMode;
+    HashTable::ProbeMode probeMode;
+    
+    const SnapshotSlot* findSlot(int key) const;
+    const char* valueOf(const SnapshotSlot& slot) const;
+    void unmap();
+
+public:
+    // Отображает снимок в память. Параметры задают таблицу, в которую
+    // снимок будет скопирован при первом изменении
+    explicit MappedHashTable(const std::string& filename,
+                             HashTable::ResizeMode mode = HashTable::ResizeMode::Immediate,
+                             HashTable::ProbeMode probe = HashTable::ProbeMode::DoubleHashing);
+    ~MappedHashTable();
+    
+    // Запрет копирования
+    MappedHashTable(const MappedHashTable&) = delete;
+    MappedHashTable& operator=(const MappedHashTable&) = delete;
+    
+    // Запись снимка таблицы (включая ещё не перенесённые при
+    // инкрементальном росте элементы)
+    static void writeSnapshot(const HashTable& source, const std::string& filename);
+    
+    // Основные операции. Изменения материализуют таблицу
+    void insert(int key, const std::string& value);
+    std::string search(int key) const;
+    void remove(int key);
+    
+    // Поиск без копирования: указатель на байты значения и их длина.
+    // Пока таблица не материализована, указатель ведёт прямо в образ
+    bool find(int key, const char*& data, size_t& length) const;
+    bool contains(int key) const;
+    
+    // Копирует образ в обычную таблицу и освобождает отображение
+    void materialize();
+    
+    // Утилиты
+    bool isMapped() const { return image != nullptr; }
+    int getSize() const;
+    bool isEmpty() const { return getSize() == 0; }
+};
+
+#endif
\ No newline at end of file
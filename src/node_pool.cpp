@@ -0,0 +1,60 @@
+#include "node_pool.h"
+#include <algorithm>
+
+constexpr size_t NodePool::MIN_SLAB_BLOCKS;
+constexpr size_t NodePool::MAX_SLAB_BYTES;
+
+NodePool::NodePool(size_t nodeSize)
+    : cursor(nullptr), limit(nullptr), freeList(nullptr) {
+    // Блок вмещает указатель списка свободных и выровнен как результат new
+    const size_t alignment = alignof(std::max_align_t);
+    size_t size = std::max(nodeSize, sizeof(FreeBlock));
+    blockSize = (size + alignment - 1) / alignment * alignment;
+    maxSlabBlocks = std::max<size_t>(MAX_SLAB_BYTES / blockSize, 1);
+    nextSlabBlocks = std::min(MIN_SLAB_BLOCKS, maxSlabBlocks);
+}
+
+NodePool::~NodePool() {
+    release();
+}
+
+void NodePool::addSlab() {
+    size_t bytes = blockSize * nextSlabBlocks;
+    slabs.reserve(slabs.size() + 1);
+    char* slab = static_cast<char*>(::operator new(bytes));
+    slabs.push_back(slab);
+    cursor = slab;
+    limit = slab + bytes;
+    nextSlabBlocks = std::min(nextSlabBlocks * 2, maxSlabBlocks);
+}
+
+void* NodePool::allocate() {
+    if (freeList != nullptr) {
+        FreeBlock* block = freeList;
+        freeList = block->next;
+        return block;
+    }
+    
+    if (cursor == limit) {
+        addSlab();
+    }
+    void* block = cursor;
+    cursor += blockSize;
+    return block;
+}
+
+void NodePool::deallocate(void* block) {
+    FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = freeList;
+    freeList = freeBlock;
+}
+
+void NodePool::release() {
+    for (void* slab : slabs) {
+        ::operator delete(slab);
+    }
+    slabs.clear();
+    cursor = limit = nullptr;
+    freeList = nullptr;
+    nextSlabBlocks = std::min(MIN_SLAB_BLOCKS, maxSlabBlocks);
+}
\ No newline at end of file
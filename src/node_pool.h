@@ -0,0 +1,87 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>
+#include <vector>
+#include <new>
+#include <utility>
+
+// Способ выделения узлов контейнера: Heap — каждый узел через new,
+// Pooled — из собственного пула контейнера (NodePool)
+enum class NodeAllocation { Heap, Pooled };
+
+// Пул блоков одного размера для узлов контейнеров. Память берётся
+// крупными плитами (slabs), растущими вдвое, и раздаётся сдвигом указателя,
+// так что соседние узлы лежат рядом. Освобождённые блоки идут в список
+// свободных и выдаются повторно. release() отдаёт все плиты разом:
+// контейнер вызывает деструкторы узлов и освобождает память одним шагом,
+// без free на каждый узел. Пул не потокобезопасен
+class NodePool {
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+    
+    // Плита не больше 64 КБ при любом размере блока (и узлов, и блоков
+    // развёрнутых списков): ниже порога mmap в malloc, поэтому отданные
+    // плиты переиспользуются кучей, а не возвращаются ОС. Блок крупнее
+    // предела получает плиту на один блок
+    static constexpr size_t MIN_SLAB_BLOCKS = 32;
+    static constexpr size_t MAX_SLAB_BYTES = 64 * 1024;
+    
+    size_t blockSize;
+    size_t maxSlabBlocks;
+    size_t nextSlabBlocks;
+    std::vector<void*> slabs;
+    // Невыданный остаток текущей плиты
+    char* cursor;
+    char* limit;
+    FreeBlock* freeList;
+    
+    void addSlab();
+
+public:
+    explicit NodePool(size_t nodeSize);
+    ~NodePool();
+    
+    // Запрет копирования
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    
+    // Выделение и возврат одного блока
+    void* allocate();
+    void deallocate(void* block);
+    
+    // Создание и уничтожение узла в блоке пула
+    template<typename T, typename... Args>
+    T* create(Args&&... args);
+    template<typename T>
+    void destroy(T* node);
+    
+    // Освобождение всех плит. Деструкторы узлов должны быть уже вызваны
+    void release();
+    
+    // Статистика
+    size_t getBlockSize() const { return blockSize; }
+    size_t getSlabCount() const { return slabs.size(); }
+    size_t getMaxSlabBlocks() const { return maxSlabBlocks; }
+};
+
+template<typename T, typename... Args>
+T* NodePool::create(Args&&... args) {
+    void* block = allocate();
+    try {
+        return new (block) T(std::forward<Args>(args)...);
+    } catch (...) {
+        deallocate(block);
+        throw;
+    }
+}
+
+template<typename T>
+void NodePool::destroy(T* node) {
+    node->~T();
+    deallocate(node);
+}
+
+#endif
\ No newline at end of file
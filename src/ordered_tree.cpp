@@ -0,0 +1,216 @@
+#include "ordered_tree.h"
+#include <stdexcept>
+#include <algorithm>
+
+OrderedTree::OrderedTree() : root(nullptr) {}
+
+OrderedTree::~OrderedTree() {
+    clear();
+}
+
+void OrderedTree::clear() {
+    destroyTree(root);
+    root = nullptr;
+}
+
+void OrderedTree::destroyTree(TreeNode* node) {
+    if (node != nullptr) {
+        destroyTree(node->left);
+        destroyTree(node->right);
+        delete node;
+    }
+}
+
+void OrderedTree::update(TreeNode* node) {
+    node->height = 1 + std::max(heightOf(node->left), heightOf(node->right));
+    node->size = 1 + sizeOf(node->left) + sizeOf(node->right);
+}
+
+OrderedTree::TreeNode* OrderedTree::rotateLeft(TreeNode* node) {
+    TreeNode* pivot = node->right;
+    node->right = pivot->left;
+    pivot->left = node;
+    update(node);
+    update(pivot);
+    return pivot;
+}
+
+OrderedTree::TreeNode* OrderedTree::rotateRight(TreeNode* node) {
+    TreeNode* pivot = node->left;
+    node->left = pivot->right;
+    pivot->right = node;
+    update(node);
+    update(pivot);
+    return pivot;
+}
+
+OrderedTree::TreeNode* OrderedTree::rebalance(TreeNode* node) {
+    update(node);
+    int balance = heightOf(node->left) - heightOf(node->right);
+    
+    if (balance > 1) {
+        // Перекос влево; при перекосе левого потомка вправо — двойной поворот
+        if (heightOf(node->left->left) < heightOf(node->left->right)) {
+            node->left = rotateLeft(node->left);
+        }
+        return rotateRight(node);
+    }
+    if (balance < -1) {
+        if (heightOf(node->right->right) < heightOf(node->right->left)) {
+            node->right = rotateRight(node->right);
+        }
+        return rotateLeft(node);
+    }
+    
+    return node;
+}
+
+OrderedTree::TreeNode* OrderedTree::insertHelper(TreeNode* node, const std::string& value,
+                                                 bool& inserted) {
+    if (node == nullptr) {
+        inserted = true;
+        return new TreeNode(value);
+    }
+    
+    if (value < node->data) {
+        node->left = insertHelper(node->left, value, inserted);
+    } else if (node->data < value) {
+        node->right = insertHelper(node->right, value, inserted);
+    } else {
+        return node;
+    }
+    
+    return inserted ? rebalance(node) : node;
+}
+
+void OrderedTree::insert(const std::string& value) {
+    bool inserted = false;
+    root = insertHelper(root, value, inserted);
+}
+
+bool OrderedTree::search(const std::string& value) const {
+    TreeNode* node = root;
+    while (node != nullptr) {
+        if (value < node->data) {
+            node = node->left;
+        } else if (node->data < value) {
+            node = node->right;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+OrderedTree::TreeNode* OrderedTree::removeMin(TreeNode* node, TreeNode*& minNode) {
+    if (node->left == nullptr) {
+        minNode = node;
+        return node->right;
+    }
+    node->left = removeMin(node->left, minNode);
+    return rebalance(node);
+}
+
+OrderedTree::TreeNode* OrderedTree::removeHelper(TreeNode* node, const std::string& value,
+                                                 bool& removed) {
+    if (node == nullptr) return nullptr;
+    
+    if (value < node->data) {
+        node->left = removeHelper(node->left, value, removed);
+    } else if (node->data < value) {
+        node->right = removeHelper(node->right, value, removed);
+    } else {
+        removed = true;
+        TreeNode* left = node->left;
+        TreeNode* right = node->right;
+        delete node;
+        
+        if (right == nullptr) {
+            return left;
+        }
+        
+        // Место удалённого узла занимает минимальный узел правого поддерева
+        TreeNode* successor = nullptr;
+        right = removeMin(right, successor);
+        successor->left = left;
+        successor->right = right;
+        return rebalance(successor);
+    }
+    
+    return removed ? rebalance(node) : node;
+}
+
+void OrderedTree::remove(const std::string& value) {
+    bool removed = false;
+    root = removeHelper(root, value, removed);
+}
+
+const std::string* OrderedTree::lowerBound(const std::string& value) const {
+    const std::string* result = nullptr;
+    TreeNode* node = root;
+    while (node != nullptr) {
+        if (node->data < value) {
+            node = node->right;
+        } else {
+            result = &node->data;
+            node = node->left;
+        }
+    }
+    return result;
+}
+
+const std::string& OrderedTree::kth(int k) const {
+    if (k < 0 || k >= size()) {
+        throw std::out_of_range("Index out of range");
+    }
+    
+    TreeNode* node = root;
+    while (true) {
+        int leftSize = sizeOf(node->left);
+        if (k < leftSize) {
+            node = node->left;
+        } else if (k > leftSize) {
+            k -= leftSize + 1;
+            node = node->right;
+        } else {
+            return node->data;
+        }
+    }
+}
+
+int OrderedTree::rank(const std::string& value) const {
+    int result = 0;
+    TreeNode* node = root;
+    while (node != nullptr) {
+        if (node->data < value) {
+            result += sizeOf(node->left) + 1;
+            node = node->right;
+        } else {
+            node = node->left;
+        }
+    }
+    return result;
+}
+
+std::vector<std::string> OrderedTree::range(const std::string& low, const std::string& high) const {
+    std::vector<std::string> result;
+    forEachInRange(low, high, [&result](const std::string& value) {
+        result.push_back(value);
+    });
+    return result;
+}
+
+void OrderedTree::inorderHelper(TreeNode* node, std::vector<std::string>& result) const {
+    if (node != nullptr) {
+        inorderHelper(node->left, result);
+        result.push_back(node->data);
+        inorderHelper(node->right, result);
+    }
+}
+
+std::vector<std::string> OrderedTree::inorder() const {
+    std::vector<std::string> result;
+    result.reserve(size());
+    inorderHelper(root, result);
+    return result;
+}
\ No newline at end of file
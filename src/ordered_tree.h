@@ -0,0 +1,109 @@
+#ifndef ORDERED_TREE_H
+#define ORDERED_TREE_H
+
+#include <string>
+#include <vector>
+
+// Упорядоченное дерево поиска (АВЛ-дерево) над строками.
+// В отличие от Tree хранит множество значений в порядке сортировки:
+// поиск, вставка и удаление стоят O(log n). Каждый узел помнит размер
+// своего поддерева, поэтому k-й элемент и ранг значения тоже O(log n)
+class OrderedTree {
+private:
+    struct TreeNode {
+        std::string data;
+        TreeNode* left;
+        TreeNode* right;
+        // Высота поддерева (у листа 0) и число узлов в нём
+        int height;
+        int size;
+        
+        TreeNode(const std::string& value)
+            : data(value), left(nullptr), right(nullptr), height(0), size(1) {}
+    };
+    
+    TreeNode* root;
+    
+    // Вспомогательные рекурсивные методы
+    TreeNode* insertHelper(TreeNode* node, const std::string& value, bool& inserted);
+    TreeNode* removeHelper(TreeNode* node, const std::string& value, bool& removed);
+    TreeNode* removeMin(TreeNode* node, TreeNode*& minNode);
+    void destroyTree(TreeNode* node);
+    void inorderHelper(TreeNode* node, std::vector<std::string>& result) const;
+    template<typename Visitor>
+    void rangeHelper(TreeNode* node, const std::string& low, const std::string& high,
+                     Visitor& visitor) const;
+    
+    // Балансировка
+    static int heightOf(TreeNode* node) { return node == nullptr ? -1 : node->height; }
+    static int sizeOf(TreeNode* node) { return node == nullptr ? 0 : node->size; }
+    static void update(TreeNode* node);
+    static TreeNode* rotateLeft(TreeNode* node);
+    static TreeNode* rotateRight(TreeNode* node);
+    static TreeNode* rebalance(TreeNode* node);
+
+public:
+    // Конструкторы и деструктор
+    OrderedTree();
+    ~OrderedTree();
+    
+    // Запрет копирования
+    OrderedTree(const OrderedTree&) = delete;
+    OrderedTree& operator=(const OrderedTree&) = delete;
+    
+    // Основные операции (повторная вставка значения ничего не меняет)
+    void insert(const std::string& value);
+    bool search(const std::string& value) const;
+    void remove(const std::string& value);
+    
+    // Упорядоченные запросы
+    // Наименьшее значение, не меньшее заданного (nullptr, если такого нет)
+    const std::string* lowerBound(const std::string& value) const;
+    // k-е по порядку значение, начиная с нуля
+    const std::string& kth(int k) const;
+    // Количество значений, меньших заданного
+    int rank(const std::string& value) const;
+    // Значения из полуинтервала [low, high) по возрастанию
+    std::vector<std::string> range(const std::string& low, const std::string& high) const;
+    template<typename Visitor>
+    void forEachInRange(const std::string& low, const std::string& high, Visitor visitor) const;
+    
+    // Обход по возрастанию
+    std::vector<std::string> inorder() const;
+    
+    // Утилиты
+    int height() const { return heightOf(root); }
+    int size() const { return sizeOf(root); }
+    bool isEmpty() const { return root == nullptr; }
+    void clear();
+    
+    // Для тестирования
+    const TreeNode* getRoot() const { return root; }
+};
+
+template<typename Visitor>
+void OrderedTree::rangeHelper(TreeNode* node, const std::string& low, const std::string& high,
+                              Visitor& visitor) const {
+    if (node == nullptr) return;
+    
+    // Поддеревья, целиком лежащие вне интервала, не посещаются
+    bool aboveLow = !(node->data < low);
+    bool belowHigh = node->data < high;
+    if (aboveLow) {
+        rangeHelper(node->left, low, high, visitor);
+    }
+    if (aboveLow && belowHigh) {
+        visitor(node->data);
+    }
+    if (belowHigh) {
+        rangeHelper(node->right, low, high, visitor);
+    }
+}
+
+template<typename Visitor>
+void OrderedTree::forEachInRange(const std::string& low, const std::string& high,
+                                 Visitor visitor) const {
+    rangeHelper(root, low, high, visitor);
+}
+
+#endif
\ No newline at end of file
@@ -3,20 +3,92 @@
 #include <fstream>
 #include <stdexcept>
 
-Queue::Queue() : front(nullptr), rear(nullptr), size(0) {}
+constexpr size_t Queue::MIN_RING_CAPACITY;
+
+Queue::Queue(NodeAllocation allocation)
+    : Queue(StorageMode::Linked, allocation) {}
+
+// Пул нужен только узлам: в режиме Ring он не создаётся
+Queue::Queue(StorageMode mode, NodeAllocation allocation)
+    : front(nullptr), rear(nullptr), size(0), storageMode(mode),
+      pool(allocation == NodeAllocation::Pooled && mode == StorageMode::Linked
+           ? new NodePool(sizeof(Node)) : nullptr),
+      ringFront(0) {}
 
 Queue::~Queue() {
     clear();
 }
 
 void Queue::clear() {
+    // Буфер сохраняет ёмкость, освобождается только память строк
+    if (isRing()) {
+        for (int i = 0; i < size; i++) {
+            std::string().swap(ringAt(i));
+        }
+        ringFront = 0;
+        size = 0;
+        return;
+    }
+    
+    // Узлы пула не возвращаются по одному: после деструкторов
+    // все плиты освобождаются разом
+    if (pool) {
+        while (front != nullptr) {
+            Node* temp = front;
+            front = front->next;
+            temp->~Node();
+        }
+        pool->release();
+        rear = nullptr;
+        size = 0;
+        return;
+    }
+    
     while (!isEmpty()) {
-        dequeue(); 
+        dequeue();
+    }
+}
+
+Queue::Node* Queue::createNode(std::string&& value) {
+    if (pool) {
+        return pool->create<Node>(std::move(value));
+    }
+    return new Node(std::move(value));
+}
+
+void Queue::destroyNode(Node* node) {
+    if (pool) {
+        pool->destroy(node);
+    } else {
+        delete node;
     }
 }
 
+void Queue::growRing() {
+    // Элементы переезжают в новый буфер по порядку, начиная с нулевой ячейки
+    std::vector<std::string> grown(ring.empty() ? MIN_RING_CAPACITY : ring.size() * 2);
+    for (int i = 0; i < size; i++) {
+        grown[i] = std::move(ringAt(i));
+    }
+    ring.swap(grown);
+    ringFront = 0;
+}
+
 void Queue::enqueue(const std::string& value) {
-    Node* newNode = new Node(value);
+    enqueue(std::string(value));
+}
+
+void Queue::enqueue(std::string&& value) {
+    if (isRing()) {
+        if (static_cast<size_t>(size) == ring.size()) {
+            growRing();
+        }
+        ringAt(size) = std::move(value);
+        size++;
+        return;
+    }
+    
+    Node* newNode = createNode(std::move(value));
     
     if (isEmpty()) {
         front = rear = newNode;
@@ -32,15 +104,23 @@ std::string Queue::dequeue() {
         throw std::runtime_error("Queue is empty");
     }
     
+    if (isRing()) {
+        // Ячейка остаётся пустой строкой без собственной памяти
+        std::string value(std::move(ring[ringFront]));
+        ringFront = (ringFront + 1) & (ring.size() - 1);
+        size--;
+        return value;
+    }
+    
     Node* temp = front;
-    std::string value = temp->data;
+    std::string value(std::move(temp->data));
     front = front->next;
     
     if (front == nullptr) {
         rear = nullptr;
     }
     
-    delete temp;
+    destroyNode(temp);
     size--;
     return value;
 }
@@ -49,19 +129,19 @@ std::string Queue::peek() const {
     if (isEmpty()) {
         throw std::runtime_error("Queue is empty");
     }
-    return front->data;
+    return isRing() ? ring[ringFront] : front->data;
 }
 
 void Queue::print() const {
-    Node* current = front;
+    bool first = true;
     std::cout << "Front -> ";
-    while (current != nullptr) {
-        std::cout << current->data;
-        if (current->next != nullptr) {
+    forEach([&first](const std::string& value) {
+        if (!first) {
             std::cout << " -> ";
         }
-        current = current->next;
-    }
+        std::cout << value;
+        first = false;
+    });
     std::cout << " -> Rear" << std::endl;
 }
 
@@ -73,13 +153,11 @@ void Queue::serializeToFile(const std::string& filename) const {
     
     file.write(reinterpret_cast<const char*>(&size), sizeof(size));
     
-    Node* current = front;
-    while (current != nullptr) {
-        int strSize = current->data.size();
+    forEach([&file](const std::string& value) {
+        int strSize = value.size();
         file.write(reinterpret_cast<const char*>(&strSize), sizeof(strSize));
-        file.write(current->data.c_str(), strSize);
-        current = current->next;
-    }
+        file.write(value.c_str(), strSize);
+    });
     
     file.close();
 }
@@ -102,7 +180,7 @@ void Queue::deserializeFromFile(const std::string& filename) {
         std::string value(strSize, '\0');
         file.read(&value[0], strSize);
         
-        enqueue(value);
+        enqueue(std::move(value));
     }
     
     file.close();
@@ -2,36 +2,78 @@
 #define QUEUE_H
 
 #include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include "node_pool.h"
 
 class Queue {
+public:
+    // Способ хранения: Linked — по узлу на элемент, Ring — кольцевой
+    // буфер в одном массиве. Буфер растёт вдвое при заполнении и не
+    // сжимается, строки перемещаются в него и из него, поэтому в
+    // установившемся режиме (очередь не растёт) память не выделяется
+    enum class StorageMode { Linked, Ring };
+
 private:
+    static constexpr size_t MIN_RING_CAPACITY = 16;
+    
     struct Node {
         std::string data;
         Node* next;
-        Node(const std::string& value) : data(value), next(nullptr) {}
+        explicit Node(std::string&& value) : data(std::move(value)), next(nullptr) {}
     };
     
     Node* front;
     Node* rear;
-    int size; 
+    int size;
+    StorageMode storageMode;
+    // Пул узлов (только в режиме NodeAllocation::Pooled)
+    std::unique_ptr<NodePool> pool;
+    // Кольцевой буфер режима Ring: ёмкость — степень двойки, первый
+    // элемент лежит в ring[ringFront]
+    std::vector<std::string> ring;
+    size_t ringFront;
     
+    Node* createNode(std::string&& value);
+    void destroyNode(Node* node);
+    bool isRing() const { return storageMode == StorageMode::Ring; }
+    std::string& ringAt(size_t offset) { return ring[(ringFront + offset) & (ring.size() - 1)]; }
+    const std::string& ringAt(size_t offset) const {
+        return ring[(ringFront + offset) & (ring.size() - 1)];
+    }
+    void growRing();
+
 public:
     // Конструкторы и деструктор
-    Queue();
+    explicit Queue(NodeAllocation allocation = NodeAllocation::Heap);
+    explicit Queue(StorageMode mode, NodeAllocation allocation = NodeAllocation::Heap);
     ~Queue();
     
     // Запрет копирования
     Queue(const Queue&) = delete;
     Queue& operator=(const Queue&) = delete;
     
-    // Основные операции
+    // Основные операции. Значение перемещается в очередь (версия
+    // с std::string&&) и из неё (dequeue) без копирования
     void enqueue(const std::string& value);
+    void enqueue(std::string&& value);
     std::string dequeue();
     std::string peek() const;
     
+    // Вызывает visitor(const std::string&) для элементов от начала к концу
+    template<typename Visitor>
+    void forEach(Visitor visitor) const;
+    
     // Утилиты
-    bool isEmpty() const { return front == nullptr; }
+    bool isEmpty() const { return size == 0; }
     int getSize() const { return size; }
+    StorageMode getStorageMode() const { return storageMode; }
+    // Ёмкость кольцевого буфера (0 в режиме Linked)
+    size_t getCapacity() const { return ring.size(); }
+    // Pooled только в режиме Linked: кольцевому буферу пул не нужен
+    NodeAllocation getAllocation() const { return pool ? NodeAllocation::Pooled : NodeAllocation::Heap; }
     void clear();
     void print() const;
     
@@ -40,4 +82,18 @@ public:
     void deserializeFromFile(const std::string& filename);
 };
 
+template<typename Visitor>
+void Queue::forEach(Visitor visitor) const {
+    if (isRing()) {
+        for (int i = 0; i < size; i++) {
+            visitor(ringAt(i));
+        }
+        return;
+    }
+    
+    for (const Node* current = front; current != nullptr; current = current->next) {
+        visitor(static_cast<const std::string&>(current->data));
+    }
+}
+
 #endif
\ No newline at end of file
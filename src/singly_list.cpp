@@ -2,51 +2,288 @@
 #include <iostream>
 #include <fstream>
 #include <stdexcept>
+#include <algorithm>
 
-SinglyList::SinglyList() : head(nullptr), tail(nullptr), size(0) {}
+constexpr int SinglyList::BLOCK_CAPACITY;
+
+SinglyList::SinglyList(NodeAllocation allocation)
+    : SinglyList(StorageMode::Linked, allocation) {}
+
+SinglyList::SinglyList(StorageMode mode, NodeAllocation allocation)
+    : head(nullptr), tail(nullptr), firstBlock(nullptr), lastBlock(nullptr), size(0),
+      storageMode(mode),
+      pool(allocation == NodeAllocation::Pooled
+           ? new NodePool(mode == StorageMode::Unrolled ? sizeof(Block) : sizeof(Node))
+           : nullptr) {}
 
 SinglyList::~SinglyList() {
     clear();
 }
 
 void SinglyList::clear() {
+    // Узлы пула не возвращаются по одному: после деструкторов
+    // все плиты освобождаются разом
     while (head != nullptr) {
         Node* temp = head;
         head = head->next;
-        delete temp;
+        if (pool) {
+            temp->~Node();
+        } else {
+            delete temp;
+        }
+    }
+    while (firstBlock != nullptr) {
+        Block* temp = firstBlock;
+        firstBlock = firstBlock->next;
+        if (pool) {
+            temp->~Block();
+        } else {
+            delete temp;
+        }
+    }
+    lastBlock = nullptr;
+    if (pool) {
+        pool->release();
+    }
+    if (index) {
+        index->clear();
     }
     tail = nullptr;
     size = 0;
 }
 
-SinglyList::Node* SinglyList::findNode(const std::string& value) const {
-    Node* current = head;
-    while (current != nullptr) {
+SinglyList::Node* SinglyList::createNode(const std::string& value) {
+    if (pool) {
+        return pool->create<Node>(value);
+    }
+    return new Node(value);
+}
+
+void SinglyList::destroyNode(Node* node) {
+    if (pool) {
+        pool->destroy(node);
+    } else {
+        delete node;
+    }
+}
+
+SinglyList::Node* SinglyList::locate(const std::string& value, Node*& prev) {
+    prev = nullptr;
+    if (index) {
+        const IndexEntry* entry = index->find(value);
+        if (entry == nullptr) {
+            return nullptr;
+        }
+        if (entry->node != nullptr) {
+            prev = entry->prev;
+            return entry->node;
+        }
+    }
+    
+    // Первое вхождение и его предшественник
+    Node* before = nullptr;
+    for (Node* current = head; current != nullptr; current = current->next) {
         if (current->data == value) {
+            prev = before;
+            // Значение, оставшееся в одном экземпляре, запоминается в индексе
+            if (index) {
+                IndexEntry* entry = index->find(value);
+                if (entry->count == 1) {
+                    entry->node = current;
+                    entry->prev = before;
+                }
+            }
             return current;
         }
-        current = current->next;
+        before = current;
     }
     return nullptr;
 }
 
-SinglyList::Node* SinglyList::findNodeBefore(const std::string& value) const {
-    if (head == nullptr || head->data == value) {
-        return nullptr;  // Элемент в голове или список пуст
+SinglyList::Node* SinglyList::findNode(const std::string& value) {
+    Node* prev;
+    return locate(value, prev);
+}
+
+SinglyList::Node* SinglyList::findNodeBefore(const std::string& value) {
+    // nullptr, если элемент в голове, не найден или список пуст
+    Node* prev;
+    locate(value, prev);
+    return prev;
+}
+
+void SinglyList::indexAdd(Node* node, Node* prev) {
+    if (!index) return;
+    
+    IndexEntry* entry = index->find(node->data);
+    if (entry == nullptr) {
+        index->insert(node->data, IndexEntry{node, prev, 1});
+    } else {
+        entry->node = entry->prev = nullptr;
+        entry->count++;
     }
+}
+
+void SinglyList::indexRemove(Node* node) {
+    if (!index) return;
     
-    Node* current = head;
-    while (current->next != nullptr) {
-        if (current->next->data == value) {
-            return current;
+    IndexEntry* entry = index->find(node->data);
+    if (entry->count == 1) {
+        index->remove(node->data);
+    } else {
+        // Какое из оставшихся вхождений первое, станет известно при поиске
+        entry->node = entry->prev = nullptr;
+        entry->count--;
+    }
+}
+
+void SinglyList::indexRelink(Node* node, Node* prev) {
+    if (!index || node == nullptr) return;
+    
+    IndexEntry* entry = index->find(node->data);
+    if (entry->node == node) {
+        entry->prev = prev;
+    }
+}
+
+void SinglyList::unlinkAfter(Node* prevNode) {
+    Node* temp = prevNode->next;
+    prevNode->next = temp->next;
+    
+    if (temp == tail) {
+        tail = prevNode;
+    }
+    
+    indexRemove(temp);
+    indexRelink(prevNode->next, prevNode);
+    destroyNode(temp);
+    size--;
+}
+
+SinglyList::Block* SinglyList::createBlock() {
+    if (pool) {
+        return pool->create<Block>();
+    }
+    return new Block();
+}
+
+void SinglyList::destroyBlock(Block* block) {
+    if (pool) {
+        pool->destroy(block);
+    } else {
+        delete block;
+    }
+}
+
+bool SinglyList::blockLocate(const std::string& value, Block*& block, int& offset,
+                             Block*& prevBlock) const {
+    prevBlock = nullptr;
+    for (block = firstBlock; block != nullptr; block = block->next) {
+        for (offset = 0; offset < block->count; offset++) {
+            if (block->items[offset] == value) {
+                return true;
+            }
         }
-        current = current->next;
+        prevBlock = block;
+    }
+    return false;
+}
+
+void SinglyList::blockInsert(Block* block, int offset, const std::string& value) {
+    if (block == nullptr) {
+        block = firstBlock = lastBlock = createBlock();
+    } else if (block->count == BLOCK_CAPACITY) {
+        Block* next = createBlock();
+        next->next = block->next;
+        block->next = next;
+        
+        if (block == lastBlock && offset == BLOCK_CAPACITY) {
+            // Дописывание в конец списка: заполненный блок не делится,
+            // иначе вставка в конец оставляла бы блоки полупустыми
+            lastBlock = next;
+            block = next;
+            offset = 0;
+        } else {
+            if (block == lastBlock) {
+                lastBlock = next;
+            }
+            const int half = BLOCK_CAPACITY / 2;
+            std::move(block->items + half, block->items + BLOCK_CAPACITY, next->items);
+            next->count = BLOCK_CAPACITY - half;
+            block->count = half;
+            if (offset > half) {
+                block = next;
+                offset -= half;
+            }
+        }
+    }
+    
+    std::move_backward(block->items + offset, block->items + block->count,
+                       block->items + block->count + 1);
+    block->items[offset] = value;
+    block->count++;
+    size++;
+}
+
+void SinglyList::blockErase(Block* block, int offset, Block* prevBlock) {
+    std::move(block->items + offset + 1, block->items + block->count, block->items + offset);
+    block->count--;
+    // Освободившаяся ячейка не должна держать память строки
+    std::string().swap(block->items[block->count]);
+    size--;
+    
+    // Блок, заполненный меньше чем наполовину, забирает следующий целиком
+    Block* next = block->next;
+    if (next != nullptr && block->count < BLOCK_CAPACITY / 2 &&
+        block->count + next->count <= BLOCK_CAPACITY) {
+        std::move(next->items, next->items + next->count, block->items + block->count);
+        block->count += next->count;
+        block->next = next->next;
+        if (next == lastBlock) {
+            lastBlock = block;
+        }
+        destroyBlock(next);
+    }
+    
+    if (block->count == 0) {
+        if (prevBlock != nullptr) {
+            prevBlock->next = block->next;
+        } else {
+            firstBlock = block->next;
+        }
+        if (block == lastBlock) {
+            lastBlock = prevBlock;
+        }
+        destroyBlock(block);
+    }
+}
+
+void SinglyList::setIndexed(bool enabled) {
+    if (enabled && isUnrolled()) {
+        throw std::logic_error("Value index requires linked storage");
+    }
+    if (!enabled) {
+        index.reset();
+        return;
+    }
+    if (index) return;
+    
+    index.reset(new ValueIndex(16, 0.75, ValueIndex::ResizeMode::Immediate,
+                               ValueIndex::ProbeMode::Grouped));
+    Node* prev = nullptr;
+    for (Node* current = head; current != nullptr; current = current->next) {
+        indexAdd(current, prev);
+        prev = current;
     }
-    return nullptr;  // Элемент не найден
 }
 
 void SinglyList::insertFront(const std::string& value) {
-    Node* newNode = new Node(value);
+    if (isUnrolled()) {
+        blockInsert(firstBlock, 0, value);
+        return;
+    }
+    
+    Node* newNode = createNode(value);
     
     if (head == nullptr) {
         head = tail = newNode;
@@ -54,11 +291,19 @@ void SinglyList::insertFront(const std::string& value) {
         newNode->next = head;
         head = newNode;
     }
+    indexAdd(newNode, nullptr);
+    indexRelink(newNode->next, newNode);
     size++;
 }
 
 void SinglyList::insertBack(const std::string& value) {
-    Node* newNode = new Node(value);
+    if (isUnrolled()) {
+        blockInsert(lastBlock, lastBlock != nullptr ? lastBlock->count : 0, value);
+        return;
+    }
+    
+    Node* newNode = createNode(value);
+    indexAdd(newNode, tail);
     
     if (tail == nullptr) {
         head = tail = newNode;
@@ -70,6 +315,16 @@ void SinglyList::insertBack(const std::string& value) {
 }
 
 void SinglyList::insertBefore(const std::string& target, const std::string& value) {
+    if (isUnrolled()) {
+        Block* block;
+        Block* prevBlock;
+        int offset;
+        if (blockLocate(target, block, offset, prevBlock)) {
+            blockInsert(block, offset, value);
+        }
+        return;
+    }
+    
     if (head == nullptr) {
         return;  // Пустой список
     }
@@ -84,21 +339,35 @@ void SinglyList::insertBefore(const std::string& target, const std::string& valu
         return;  // target не найден
     }
     
-    Node* newNode = new Node(value);
+    Node* newNode = createNode(value);
     newNode->next = prevNode->next;
     prevNode->next = newNode;
+    indexAdd(newNode, prevNode);
+    indexRelink(newNode->next, newNode);
     size++;
 }
 
 void SinglyList::insertAfter(const std::string& target, const std::string& value) {
+    if (isUnrolled()) {
+        Block* block;
+        Block* prevBlock;
+        int offset;
+        if (blockLocate(target, block, offset, prevBlock)) {
+            blockInsert(block, offset + 1, value);
+        }
+        return;
+    }
+    
     Node* targetNode = findNode(target);
     if (targetNode == nullptr) {
         return;  // target не найден
     }
     
-    Node* newNode = new Node(value);
+    Node* newNode = createNode(value);
     newNode->next = targetNode->next;
     targetNode->next = newNode;
+    indexAdd(newNode, targetNode);
+    indexRelink(newNode->next, newNode);
     
     if (targetNode == tail) {
         tail = newNode;
@@ -107,6 +376,13 @@ void SinglyList::insertAfter(const std::string& target, const std::string& value
 }
 
 void SinglyList::removeFront() {
+    if (isUnrolled()) {
+        if (firstBlock != nullptr) {
+            blockErase(firstBlock, 0, nullptr);
+        }
+        return;
+    }
+    
     if (head == nullptr) {
         return;  // Пустой список
     }
@@ -118,27 +394,57 @@ void SinglyList::removeFront() {
         tail = nullptr;  // Список стал пустым
     }
     
-    delete temp;
+    indexRemove(temp);
+    indexRelink(head, nullptr);
+    destroyNode(temp);
     size--;
 }
 
 void SinglyList::removeBack() {
+    if (isUnrolled()) {
+        if (lastBlock == nullptr) {
+            return;  // Пустой список
+        }
+        // Предыдущий блок ищется обходом блоков, а не элементов
+        Block* prevBlock = nullptr;
+        if (firstBlock != lastBlock) {
+            prevBlock = firstBlock;
+            while (prevBlock->next != lastBlock) {
+                prevBlock = prevBlock->next;
+            }
+        }
+        blockErase(lastBlock, lastBlock->count - 1, prevBlock);
+        return;
+    }
+    
     if (head == nullptr) {
         return;  // Пустой список
     }
     
     if (head == tail) {
         // Один элемент
-        delete head;
+        indexRemove(head);
+        destroyNode(head);
         head = tail = nullptr;
     } else {
-        // Несколько элементов
-        Node* current = head;
-        while (current->next != tail) {
-            current = current->next;
+        // Несколько элементов: предшественник хвоста известен индексу,
+        // если значение хвоста не повторяется, иначе ищем обходом
+        Node* current = nullptr;
+        if (index) {
+            const IndexEntry* entry = index->find(tail->data);
+            if (entry->node == tail) {
+                current = entry->prev;
+            }
+        }
+        if (current == nullptr) {
+            current = head;
+            while (current->next != tail) {
+                current = current->next;
+            }
         }
         
-        delete tail;
+        indexRemove(tail);
+        destroyNode(tail);
         tail = current;
         tail->next = nullptr;
     }
@@ -146,6 +452,16 @@ void SinglyList::removeBack() {
 }
 
 void SinglyList::removeValue(const std::string& value) {
+    if (isUnrolled()) {
+        Block* block;
+        Block* prevBlock;
+        int offset;
+        if (blockLocate(value, block, offset, prevBlock)) {
+            blockErase(block, offset, prevBlock);
+        }
+        return;
+    }
+    
     if (head == nullptr) {
         return;  // Пустой список
     }
@@ -160,18 +476,33 @@ void SinglyList::removeValue(const std::string& value) {
         return;  // Элемент не найден
     }
     
-    Node* temp = prevNode->next;
-    prevNode->next = temp->next;
-    
-    if (temp == tail) {
-        tail = prevNode;
-    }
-    
-    delete temp;
-    size--;
+    unlinkAfter(prevNode);
 }
 
 void SinglyList::removeBefore(const std::string& target) {
+    if (isUnrolled()) {
+        // Как и в режиме Linked, вхождение target в голове пропускается
+        // и удаляется элемент перед первым вхождением со второй позиции
+        Block* prevPrevBlock = nullptr;
+        Block* prevBlock = nullptr;
+        for (Block* block = firstBlock; block != nullptr; block = block->next) {
+            for (int i = 0; i < block->count; i++) {
+                if (block->items[i] != target || (block == firstBlock && i == 0)) {
+                    continue;
+                }
+                if (i > 0) {
+                    blockErase(block, i - 1, prevBlock);
+                } else {
+                    blockErase(prevBlock, prevBlock->count - 1, prevPrevBlock);
+                }
+                return;
+            }
+            prevPrevBlock = prevBlock;
+            prevBlock = block;
+        }
+        return;
+    }
+    
     if (head == nullptr || head->next == nullptr) {
         return;  // Менее двух элементов
     }
@@ -181,14 +512,34 @@ void SinglyList::removeBefore(const std::string& target) {
         return;
     }
     
+    // Неповторяющийся target: удаляемый узел и его предшественник
+    // берутся из индекса
+    if (index) {
+        const IndexEntry* entry = index->find(target);
+        if (entry == nullptr) {
+            return;  // target не найден
+        }
+        if (entry->node != nullptr) {
+            Node* temp = entry->prev;
+            if (temp == nullptr) {
+                return;  // target в голове
+            }
+            Node* before;
+            locate(temp->data, before);
+            if (before == nullptr || before->next != temp) {
+                // Значение удаляемого узла повторяется раньше него
+                for (before = head; before->next != temp; before = before->next) {}
+            }
+            unlinkAfter(before);
+            return;
+        }
+    }
+    
     // Ищем элемент, который находится за два узла до target
     Node* current = head;
     while (current->next != nullptr && current->next->next != nullptr) {
         if (current->next->next->data == target) {
-            Node* temp = current->next;
-            current->next = temp->next;
-            delete temp;
-            size--;
+            unlinkAfter(current);
             return;
         }
         current = current->next;
@@ -196,36 +547,58 @@ void SinglyList::removeBefore(const std::string& target) {
 }
 
 void SinglyList::removeAfter(const std::string& target) {
+    if (isUnrolled()) {
+        Block* block;
+        Block* prevBlock;
+        int offset;
+        if (!blockLocate(target, block, offset, prevBlock)) {
+            return;  // target не найден
+        }
+        if (offset + 1 < block->count) {
+            blockErase(block, offset + 1, prevBlock);
+        } else if (block->next != nullptr) {
+            blockErase(block->next, 0, block);
+        }
+        return;
+    }
+    
     Node* targetNode = findNode(target);
     if (targetNode == nullptr || targetNode->next == nullptr) {
         return;  // target не найден или нет элемента после него
     }
     
-    Node* temp = targetNode->next;
-    targetNode->next = temp->next;
-    
-    if (temp == tail) {
-        tail = targetNode;
-    }
-    
-    delete temp;
-    size--;
+    unlinkAfter(targetNode);
 }
 
 bool SinglyList::search(const std::string& value) const {
-    return findNode(value) != nullptr;
+    if (isUnrolled()) {
+        Block* block;
+        Block* prevBlock;
+        int offset;
+        return blockLocate(value, block, offset, prevBlock);
+    }
+    // Индекс хранит все значения списка; поиск только читает его
+    if (index) {
+        return index->contains(value);
+    }
+    for (Node* current = head; current != nullptr; current = current->next) {
+        if (current->data == value) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void SinglyList::printForward() const {
-    Node* current = head;
+    bool first = true;
     std::cout << "[";
-    while (current != nullptr) {
-        std::cout << current->data;
-        if (current->next != nullptr) {
+    forEach([&first](const std::string& value) {
+        if (!first) {
             std::cout << " -> ";
         }
-        current = current->next;
-    }
+        std::cout << value;
+        first = false;
+    });
     std::cout << "]" << std::endl;
 }
 
@@ -234,16 +607,14 @@ void SinglyList::serializeToFile(const std::string& filename) const {
     if (!file.is_open()) {
         throw std::runtime_error("Cannot open file for writing");
     }
-     
+    
     file.write(reinterpret_cast<const char*>(&size), sizeof(size));
     
-    Node* current = head;
-    while (current != nullptr) {
-        int strSize = current->data.size();
+    forEach([&file](const std::string& value) {
+        int strSize = value.size();
         file.write(reinterpret_cast<const char*>(&strSize), sizeof(strSize));
-        file.write(current->data.c_str(), strSize);
-        current = current->next;
-    }
+        file.write(value.c_str(), strSize);
+    });
     
     file.close();
 }
@@ -2,24 +2,83 @@
 #define SINGLY_LIST_H
 
 #include <string>
+#include <memory>
+#include "node_pool.h"
+#include "hash_table.h"
 
 class SinglyList {
+public:
+    // Способ хранения: Linked — по узлу на элемент, Unrolled — развёрнутый
+    // список, в узле (блоке) до BLOCK_CAPACITY элементов подряд. Блок
+    // делится пополам при переполнении и сливается со следующим, когда
+    // заполнен меньше чем наполовину, поэтому обход идёт в основном по
+    // смежной памяти, а не по указателю на каждый элемент
+    enum class StorageMode { Linked, Unrolled };
+
 private:
+    static constexpr int BLOCK_CAPACITY = 16;
+    
     struct Node {
         std::string data;
         Node* next;
         Node(const std::string& value) : data(value), next(nullptr) {}
     };
     
+    struct Block {
+        Block* next;
+        int count;
+        std::string items[BLOCK_CAPACITY];
+        Block() : next(nullptr), count(0) {}
+    };
+    
     Node* head;
     Node* tail;
+    // Блоки режима Unrolled
+    Block* firstBlock;
+    Block* lastBlock;
     int size;
+    StorageMode storageMode;
+    // Пул узлов или блоков (только в режиме NodeAllocation::Pooled)
+    std::unique_ptr<NodePool> pool;
+    
+    // Индекс значение -> узел и его предшественник. Узел известен, только
+    // если значение в списке одно (node == nullptr при повторах: тогда
+    // поиск идёт обходом, как без индекса). Индекс меняют только
+    // неконстантные методы: константные, как и без индекса, можно
+    // вызывать из нескольких потоков одновременно
+    struct IndexEntry {
+        Node* node;
+        Node* prev;
+        int count;
+    };
+    typedef BasicHashTable<std::string, IndexEntry> ValueIndex;
+    std::unique_ptr<ValueIndex> index;
     
-    Node* findNode(const std::string& value) const;
-    Node* findNodeBefore(const std::string& value) const;
+    Node* createNode(const std::string& value);
+    void destroyNode(Node* node);
+    // Поиск узла для изменяющих операций: попутно запоминает в индексе
+    // найденный узел, поэтому не константный
+    Node* locate(const std::string& value, Node*& prev);
+    Node* findNode(const std::string& value);
+    Node* findNodeBefore(const std::string& value);
+    void indexAdd(Node* node, Node* prev);
+    void indexRemove(Node* node);
+    void indexRelink(Node* node, Node* prev);
+    // Удаление узла, следующего за prevNode (он должен существовать)
+    void unlinkAfter(Node* prevNode);
     
+    // Вспомогательные методы режима Unrolled. Элемент задаётся блоком и
+    // смещением в нём; prevBlock — блок перед block (nullptr для первого)
+    bool isUnrolled() const { return storageMode == StorageMode::Unrolled; }
+    Block* createBlock();
+    void destroyBlock(Block* block);
+    bool blockLocate(const std::string& value, Block*& block, int& offset, Block*& prevBlock) const;
+    void blockInsert(Block* block, int offset, const std::string& value);
+    void blockErase(Block* block, int offset, Block* prevBlock);
+
 public:
-    SinglyList();
+    explicit SinglyList(NodeAllocation allocation = NodeAllocation::Heap);
+    explicit SinglyList(StorageMode mode, NodeAllocation allocation = NodeAllocation::Heap);
     ~SinglyList();
     
     SinglyList(const SinglyList&) = delete;
@@ -38,13 +97,42 @@ public:
     
     bool search(const std::string& value) const;
     
-    void printForward() const; 
+    // Вызывает visitor(const std::string&) для элементов от головы к хвосту
+    template<typename Visitor>
+    void forEach(Visitor visitor) const;
+    
+    // Индекс по значениям: поиск, вставка и удаление по значению за O(1)
+    // в среднем (для неповторяющихся значений) ценой хеш-таблицы рядом
+    // со списком и её обновления при каждом изменении. Только для режима
+    // Linked: в режиме Unrolled элементы переезжают между блоками
+    void setIndexed(bool enabled);
+    bool isIndexed() const { return index != nullptr; }
+    
+    void printForward() const;
     int getSize() const { return size; }
-    bool isEmpty() const { return head == nullptr; }
+    bool isEmpty() const { return size == 0; }
+    StorageMode getStorageMode() const { return storageMode; }
+    NodeAllocation getAllocation() const { return pool ? NodeAllocation::Pooled : NodeAllocation::Heap; }
     void clear();
     
     void serializeToFile(const std::string& filename) const;
     void deserializeFromFile(const std::string& filename);
 };
 
+template<typename Visitor>
+void SinglyList::forEach(Visitor visitor) const {
+    if (isUnrolled()) {
+        for (const Block* block = firstBlock; block != nullptr; block = block->next) {
+            for (int i = 0; i < block->count; i++) {
+                visitor(block->items[i]);
+            }
+        }
+        return;
+    }
+    
+    for (const Node* current = head; current != nullptr; current = current->next) {
+        visitor(static_cast<const std::string&>(current->data));
+    }
+}
+
 #endif
\ No newline at end of file
@@ -4,20 +4,72 @@
 #include <vector>
 #include <stdexcept>
 
-Stack::Stack() : top(nullptr), size(0) {}
+Stack::Stack(NodeAllocation allocation)
+    : Stack(StorageMode::Linked, allocation) {}
+
+// Пул нужен только узлам: в режиме Contiguous он не создаётся
+Stack::Stack(StorageMode mode, NodeAllocation allocation)
+    : top(nullptr), size(0), storageMode(mode),
+      pool(allocation == NodeAllocation::Pooled && mode == StorageMode::Linked
+           ? new NodePool(sizeof(Node)) : nullptr) {}
 
 Stack::~Stack() {
     clear();
 }
 
 void Stack::clear() {
+    // Массив сохраняет ёмкость
+    if (isContiguous()) {
+        items.clear();
+        size = 0;
+        return;
+    }
+    
+    // Узлы пула не возвращаются по одному: после деструкторов
+    // все плиты освобождаются разом
+    if (pool) {
+        while (top != nullptr) {
+            Node* temp = top;
+            top = top->next;
+            temp->~Node();
+        }
+        pool->release();
+        size = 0;
+        return;
+    }
+    
     while (!isEmpty()) {
-        pop(); 
+        pop();
+    }
+}
+
+Stack::Node* Stack::createNode(std::string&& value) {
+    if (pool) {
+        return pool->create<Node>(std::move(value));
+    }
+    return new Node(std::move(value));
+}
+
+void Stack::destroyNode(Node* node) {
+    if (pool) {
+        pool->destroy(node);
+    } else {
+        delete node;
     }
 }
 
 void Stack::push(const std::string& value) {
-    Node* newNode = new Node(value);
+    push(std::string(value));
+}
+
+void Stack::push(std::string&& value) {
+    if (isContiguous()) {
+        items.push_back(std::move(value));
+        size++;
+        return;
+    }
+    
+    Node* newNode = createNode(std::move(value));
     newNode->next = top;
     top = newNode;
     size++;
@@ -28,10 +80,17 @@ std::string Stack::pop() {
         throw std::runtime_error("Stack is empty");
     }
     
+    if (isContiguous()) {
+        std::string value(std::move(items.back()));
+        items.pop_back();
+        size--;
+        return value;
+    }
+    
     Node* temp = top;
-    std::string value = temp->data;
+    std::string value(std::move(temp->data));
     top = top->next;
-    delete temp;
+    destroyNode(temp);
     size--;
     
     return value;
@@ -41,19 +100,19 @@ std::string Stack::peek() const {
     if (isEmpty()) {
         throw std::runtime_error("Stack is empty");
     }
-    return top->data;
+    return isContiguous() ? items.back() : top->data;
 }
 
 void Stack::print() const {
-    Node* current = top;
+    bool first = true;
     std::cout << "Top -> ";
-    while (current != nullptr) {
-        std::cout << current->data;
-        if (current->next != nullptr) {
+    forEach([&first](const std::string& value) {
+        if (!first) {
             std::cout << " -> ";
         }
-        current = current->next;
-    }
+        std::cout << value;
+        first = false;
+    });
     std::cout << " -> Bottom" << std::endl;
 }
 
@@ -64,22 +123,21 @@ void Stack::serializeToFile(const std::string& filename) const {
         throw std::runtime_error("Cannot open file for writing");
     }
     
-    // Сначала собираем все элементы в вектор
-    std::vector<std::string> elements;
-    Node* current = top;
-    while (current != nullptr) {
-        elements.push_back(current->data);
-        current = current->next;
-    }
+    // Сначала собираем указатели на элементы от вершины ко дну
+    std::vector<const std::string*> elements;
+    elements.reserve(size);
+    forEach([&elements](const std::string& value) {
+        elements.push_back(&value);
+    });
     
     // Сохраняем в обратном порядке (чтобы при загрузке push восстанавливал порядок)
     int elemSize = elements.size();
     file.write(reinterpret_cast<const char*>(&elemSize), sizeof(elemSize));
     
     for (int i = elemSize - 1; i >= 0; i--) {
-        int strSize = elements[i].size();
+        int strSize = elements[i]->size();
         file.write(reinterpret_cast<const char*>(&strSize), sizeof(strSize));
-        file.write(elements[i].c_str(), strSize);
+        file.write(elements[i]->c_str(), strSize);
     }
     
     file.close();
@@ -104,7 +162,7 @@ void Stack::deserializeFromFile(const std::string& filename) {
         file.read(&value[0], strSize);
         
         // Push в стек (восстанавливаем порядок)
-        push(value);
+        push(std::move(value));
     }
     
     file.close();
@@ -2,35 +2,70 @@
 #define STACK_H
 
 #include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include "node_pool.h"
 
 class Stack {
+public:
+    // Способ хранения: Linked — по узлу на элемент, Contiguous — элементы
+    // подряд в одном массиве, вершина в конце. Массив не сжимается, строки
+    // перемещаются в него и из него, поэтому в установившемся режиме
+    // (стек не растёт) память не выделяется
+    enum class StorageMode { Linked, Contiguous };
+
 private:
     struct Node {
         std::string data;
         Node* next;
-        Node(const std::string& value) : data(value), next(nullptr) {}
+        explicit Node(std::string&& value) : data(std::move(value)), next(nullptr) {}
     };
     
     Node* top;
     int size;
+    StorageMode storageMode;
+    // Пул узлов (только в режиме NodeAllocation::Pooled)
+    std::unique_ptr<NodePool> pool;
+    // Элементы режима Contiguous от дна к вершине
+    std::vector<std::string> items;
     
+    Node* createNode(std::string&& value);
+    void destroyNode(Node* node);
+    bool isContiguous() const { return storageMode == StorageMode::Contiguous; }
+
 public:
     // Конструкторы и деструктор
-    Stack();
+    explicit Stack(NodeAllocation allocation = NodeAllocation::Heap);
+    explicit Stack(StorageMode mode, NodeAllocation allocation = NodeAllocation::Heap);
     ~Stack();
     
     // Запрет копирования
     Stack(const Stack&) = delete;
     Stack& operator=(const Stack&) = delete;
     
-    // Основные операции
+    // Основные операции. Значение перемещается в стек (push с
+    // std::string&&, emplace строит его на месте) и из него (pop)
     void push(const std::string& value);
+    void push(std::string&& value);
+    template<typename... Args>
+    void emplace(Args&&... args);
     std::string pop();
-    std::string peek() const; 
+    std::string peek() const;
+    
+    // Вызывает visitor(const std::string&) для элементов от вершины ко дну
+    template<typename Visitor>
+    void forEach(Visitor visitor) const;
     
     // Утилиты
-    bool isEmpty() const { return top == nullptr; }
+    bool isEmpty() const { return size == 0; }
     int getSize() const { return size; }
+    StorageMode getStorageMode() const { return storageMode; }
+    // Ёмкость массива (0 в режиме Linked)
+    size_t getCapacity() const { return items.capacity(); }
+    // Pooled только в режиме Linked: массиву пул не нужен
+    NodeAllocation getAllocation() const { return pool ? NodeAllocation::Pooled : NodeAllocation::Heap; }
     void clear();
     void print() const;
     
@@ -39,4 +74,28 @@ public:
     void deserializeFromFile(const std::string& filename);
 };
 
+template<typename... Args>
+void Stack::emplace(Args&&... args) {
+    if (isContiguous()) {
+        items.emplace_back(std::forward<Args>(args)...);
+        size++;
+        return;
+    }
+    push(std::string(std::forward<Args>(args)...));
+}
+
+template<typename Visitor>
+void Stack::forEach(Visitor visitor) const {
+    if (isContiguous()) {
+        for (size_t i = items.size(); i > 0; i--) {
+            visitor(items[i - 1]);
+        }
+        return;
+    }
+    
+    for (const Node* current = top; current != nullptr; current = current->next) {
+        visitor(static_cast<const std::string&>(current->data));
+    }
+}
+
 #endif
\ No newline at end of file
@@ -6,72 +6,192 @@
 #include <vector>
 #include <algorithm>
 #include <sstream>
+#include <cstdint>
+#include <thread>
+#include <exception>
+#include <mutex>
 
-Tree::Tree() : root(nullptr) {}
+constexpr size_t Tree::NO_INDEX;
+constexpr unsigned char Tree::SHAPE_FULL;
+constexpr unsigned char Tree::SHAPE_COMPLETE;
+constexpr unsigned char Tree::SHAPE_PERFECT;
+constexpr unsigned char Tree::SHAPE_ALL;
+
+// "L3TC" — компактный формат файла дерева: заголовок (сигнатура, число узлов,
+// размеры блока длин и блока значений), форма в порядке обхода в ширину
+// по два бита на узел (есть левый потомок, есть правый), длины значений
+// в varint и все значения подряд
+const uint32_t TREE_MAGIC = 0x4354334C;
+
+// Длина в формате varint: по 7 бит в байте, старший бит — продолжение
+static void writeVarint(std::string& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+static bool readVarint(const std::string& in, size_t& position, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35 && position < in.size(); shift += 7) {
+        unsigned char byte = in[position++];
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Число непрочитанных байт потока; для потока без позиционирования —
+// максимум, тогда нехватку данных покажет само чтение
+static uint64_t remainingBytes(std::istream& in) {
+    std::streampos current = in.tellg();
+    if (current == std::streampos(-1)) {
+        return UINT64_MAX;
+    }
+    in.seekg(0, std::ios::end);
+    std::streampos end = in.tellg();
+    in.seekg(current);
+    if (end == std::streampos(-1) || !in) {
+        in.clear();
+        return UINT64_MAX;
+    }
+    return static_cast<uint64_t>(end - current);
+}
+
+// Пул нужен только узлам: в режиме Implicit он не создаётся
+Tree::Tree(StorageMode mode, NodeAllocation allocation)
+    : root(nullptr),
+      nodeCount(0),
+      storageMode(mode),
+      pool(allocation == NodeAllocation::Pooled && mode == StorageMode::Linked
+           ? new NodePool(sizeof(TreeNode)) : nullptr) {}
 
 Tree::~Tree() {
     clear();
 }
 
 void Tree::clear() {
-    destroyTree(root); 
+    destroyTree(root);
     root = nullptr;
+    // Блоки пула уже возвращены в список свободных; плиты отдаются разом
+    if (pool) {
+        pool->release();
+    }
+    nodeCount = 0;
+    std::vector<std::string>().swap(nodes);
 }
 
+// Обходы и уничтожение используют явный стек вместо рекурсии: глубина
+// вырожденного дерева (например, прочитанного из файла) может достигать
+// числа узлов, и рекурсия переполнила бы стек вызовов
 void Tree::destroyTree(TreeNode* node) {
-    if (node != nullptr) {
-        destroyTree(node->left);
-        destroyTree(node->right);
+    if (node == nullptr) return;
+    
+    std::vector<TreeNode*> stack(1, node);
+    while (!stack.empty()) {
+        TreeNode* current = stack.back();
+        stack.pop_back();
+        if (current->left != nullptr) {
+            stack.push_back(current->left);
+        }
+        if (current->right != nullptr) {
+            stack.push_back(current->right);
+        }
+        destroyNode(current);
+    }
+}
+
+Tree::TreeNode* Tree::createNode(const std::string& value) {
+    if (pool) {
+        return pool->create<TreeNode>(value);
+    }
+    return new TreeNode(value);
+}
+
+void Tree::destroyNode(TreeNode* node) {
+    if (pool) {
+        pool->destroy(node);
+    } else {
         delete node;
     }
 }
 
-Tree::TreeNode* Tree::insertHelper(TreeNode* node, const std::string& value) {
+Tree::TreeNode* Tree::insertHelper(TreeNode* node, const std::string& value, bool& changed) {
     if (node == nullptr) {
-        return new TreeNode(value);
+        changed = true;
+        return createNode(value);
     }
     
     // Для полного бинарного дерева вставляем в первую доступную позицию
     // Используем обход в ширину для нахождения первой свободной позиции
     if (node->left == nullptr) {
-        node->left = new TreeNode(value);
+        node->left = createNode(value);
+        changed = true;
     } else if (node->right == nullptr) {
-        node->right = new TreeNode(value);
+        node->right = createNode(value);
+        changed = true;
     } else {
         // Если оба потомка существуют, рекурсивно вставляем в левое поддерево
-        // Для поддержания свойства полноты
+        // Для поддержания свойства полноты. Высоты потомков хранятся
+        // в узлах, поэтому спуск стоит O(log n), а не обход поддеревьев
         if (heightHelper(node->left) <= heightHelper(node->right)) {
-            node->left = insertHelper(node->left, value);
+            node->left = insertHelper(node->left, value, changed);
         } else {
-            node->right = insertHelper(node->right, value);
+            node->right = insertHelper(node->right, value, changed);
         }
     }
     
+    // Если высота и форма поддерева не изменились, выше по пути
+    // пересчитывать нечего
+    changed = changed && updateNode(node);
     return node;
 }
 
 void Tree::insert(const std::string& value) {
+    // Следующая свободная позиция полного дерева — конец массива
+    if (isImplicit()) {
+        nodes.push_back(value);
+        return;
+    }
+    
     if (root == nullptr) {
-        root = new TreeNode(value);
+        root = createNode(value);
     } else {
-        root = insertHelper(root, value);
+        bool changed = false;
+        root = insertHelper(root, value, changed);
     }
+    nodeCount++;
 }
 
 Tree::TreeNode* Tree::searchHelper(TreeNode* node, const std::string& value) const {
-    if (node == nullptr || node->data == value) {
-        return node;
-    }
+    if (node == nullptr) return nullptr;
     
-    TreeNode* leftResult = searchHelper(node->left, value);
-    if (leftResult != nullptr) {
-        return leftResult;
+    // Прямой порядок: левое поддерево проверяется раньше правого
+    std::vector<TreeNode*> stack(1, node);
+    while (!stack.empty()) {
+        TreeNode* current = stack.back();
+        stack.pop_back();
+        if (current->data == value) {
+            return current;
+        }
+        if (current->right != nullptr) {
+            stack.push_back(current->right);
+        }
+        if (current->left != nullptr) {
+            stack.push_back(current->left);
+        }
     }
     
-    return searchHelper(node->right, value);
+    return nullptr;
 }
 
 bool Tree::search(const std::string& value) const {
+    if (isImplicit()) {
+        return std::find(nodes.begin(), nodes.end(), value) != nodes.end();
+    }
     return searchHelper(root, value) != nullptr;
 }
 
@@ -80,104 +200,215 @@ Tree::TreeNode* Tree::findMin(TreeNode* node) const {
     
     // Для небинарного дерева поиска просто ищем минимальное по алфавиту
     TreeNode* minNode = node;
-    TreeNode* leftMin = findMin(node->left);
-    TreeNode* rightMin = findMin(node->right);
-    
-    if (leftMin != nullptr && leftMin->data < minNode->data) {
-        minNode = leftMin;
-    }
-    if (rightMin != nullptr && rightMin->data < minNode->data) {
-        minNode = rightMin;
+    std::vector<TreeNode*> stack(1, node);
+    while (!stack.empty()) {
+        TreeNode* current = stack.back();
+        stack.pop_back();
+        if (current->data < minNode->data) {
+            minNode = current;
+        }
+        if (current->right != nullptr) {
+            stack.push_back(current->right);
+        }
+        if (current->left != nullptr) {
+            stack.push_back(current->left);
+        }
     }
     
     return minNode;
 }
 
 Tree::TreeNode* Tree::removeHelper(TreeNode* node, const std::string& value) {
-    if (node == nullptr) return nullptr;
+    // Кадр стека — ссылка на указатель на узел и удаляемое значение.
+    // Узел с двумя потомками удаляет из правого поддерева уже другое
+    // значение (перенесённый минимум), поэтому значение хранится в кадре
+    struct Frame {
+        TreeNode** link;
+        const std::string* value;
+        bool visited;
+    };
+    
+    std::vector<Frame> stack;
+    stack.push_back({&node, &value, false});
     
-    if (node->data == value) {
-        // Узел найден
-        if (node->left == nullptr && node->right == nullptr) {
-            // Лист
-            delete node;
-            return nullptr;
-        } else if (node->left == nullptr) {
-            TreeNode* temp = node->right;
-            delete node;
-            return temp;
-        } else if (node->right == nullptr) {
-            TreeNode* temp = node->left;
-            delete node;
-            return temp;
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+        TreeNode* current = *frame.link;
+        
+        // Потомки обработаны — пересчитываем высоту на обратном пути
+        if (frame.visited) {
+            updateNode(current);
+            stack.pop_back();
+            continue;
+        }
+        
+        if (current == nullptr) {
+            stack.pop_back();
+            continue;
+        }
+        
+        if (current->data == *frame.value) {
+            // Узел найден
+            if (current->left == nullptr || current->right == nullptr) {
+                // Лист или узел с одним потомком
+                *frame.link = current->left != nullptr ? current->left : current->right;
+                destroyNode(current);
+                nodeCount--;
+                stack.pop_back();
+            } else {
+                // Узел с двумя потомками
+                // Для полного бинарного дерева просто удаляем
+                // Можно заменить на самый нижний правый лист
+                TreeNode* temp = findMin(current->right);
+                current->data = temp->data;
+                frame.visited = true;
+                stack.push_back({&current->right, &current->data, false});
+            }
         } else {
-            // Узел с двумя потомками
-            // Для полного бинарного дерева просто удаляем
-            // Можно заменить на самый нижний правый лист
-            TreeNode* temp = findMin(node->right);
-            node->data = temp->data;
-            node->right = removeHelper(node->right, temp->data);
+            const std::string* target = frame.value;
+            frame.visited = true;
+            stack.push_back({&current->right, target, false});
+            stack.push_back({&current->left, target, false});
         }
-    } else {
-        node->left = removeHelper(node->left, value);
-        node->right = removeHelper(node->right, value);
     }
     
     return node;
 }
 
 void Tree::remove(const std::string& value) {
+    // Удалённый узел замещается последним, и дерево остаётся полным
+    if (isImplicit()) {
+        auto it = std::find(nodes.begin(), nodes.end(), value);
+        if (it != nodes.end()) {
+            if (it + 1 != nodes.end()) {
+                *it = std::move(nodes.back());
+            }
+            nodes.pop_back();
+        }
+        return;
+    }
     root = removeHelper(root, value);
 }
 
 void Tree::inorderHelper(TreeNode* node, std::vector<std::string>& result) const {
-    if (node != nullptr) {
-        inorderHelper(node->left, result);
-        result.push_back(node->data);
-        inorderHelper(node->right, result);
+    std::vector<TreeNode*> stack;
+    TreeNode* current = node;
+    
+    while (current != nullptr || !stack.empty()) {
+        // Спускаемся по левой ветви, запоминая путь
+        while (current != nullptr) {
+            stack.push_back(current);
+            current = current->left;
+        }
+        current = stack.back();
+        stack.pop_back();
+        result.push_back(current->data);
+        current = current->right;
     }
 }
 
 std::vector<std::string> Tree::inorder() const {
     std::vector<std::string> result;
+    if (isImplicit()) {
+        result.reserve(nodes.size());
+        inorderIndex(0, result);
+        return result;
+    }
     inorderHelper(root, result);
     return result;
 }
 
 void Tree::preorderHelper(TreeNode* node, std::vector<std::string>& result) const {
-    if (node != nullptr) {
-        result.push_back(node->data);
-        preorderHelper(node->left, result);
-        preorderHelper(node->right, result);
+    if (node == nullptr) return;
+    
+    std::vector<TreeNode*> stack(1, node);
+    while (!stack.empty()) {
+        TreeNode* current = stack.back();
+        stack.pop_back();
+        result.push_back(current->data);
+        if (current->right != nullptr) {
+            stack.push_back(current->right);
+        }
+        if (current->left != nullptr) {
+            stack.push_back(current->left);
+        }
     }
 }
 
 std::vector<std::string> Tree::preorder() const {
     std::vector<std::string> result;
+    if (isImplicit()) {
+        result.reserve(nodes.size());
+        preorderIndex(0, result);
+        return result;
+    }
     preorderHelper(root, result);
     return result;
 }
 
 void Tree::postorderHelper(TreeNode* node, std::vector<std::string>& result) const {
-    if (node != nullptr) {
-        postorderHelper(node->left, result);
-        postorderHelper(node->right, result);
-        result.push_back(node->data);
+    std::vector<TreeNode*> stack;
+    TreeNode* current = node;
+    TreeNode* lastVisited = nullptr;
+    
+    while (current != nullptr || !stack.empty()) {
+        while (current != nullptr) {
+            stack.push_back(current);
+            current = current->left;
+        }
+        
+        // Узел выводится, когда его правое поддерево уже пройдено
+        TreeNode* top = stack.back();
+        if (top->right != nullptr && top->right != lastVisited) {
+            current = top->right;
+        } else {
+            result.push_back(top->data);
+            lastVisited = top;
+            stack.pop_back();
+        }
+    }
+}
+
+void Tree::inorderIndex(size_t index, std::vector<std::string>& result) const {
+    if (index < nodes.size()) {
+        inorderIndex(2 * index + 1, result);
+        result.push_back(nodes[index]);
+        inorderIndex(2 * index + 2, result);
+    }
+}
+
+void Tree::preorderIndex(size_t index, std::vector<std::string>& result) const {
+    if (index < nodes.size()) {
+        result.push_back(nodes[index]);
+        preorderIndex(2 * index + 1, result);
+        preorderIndex(2 * index + 2, result);
+    }
+}
+
+void Tree::postorderIndex(size_t index, std::vector<std::string>& result) const {
+    if (index < nodes.size()) {
+        postorderIndex(2 * index + 1, result);
+        postorderIndex(2 * index + 2, result);
+        result.push_back(nodes[index]);
     }
 }
 
 std::vector<std::string> Tree::postorder() const {
     std::vector<std::string> result;
+    if (isImplicit()) {
+        result.reserve(nodes.size());
+        postorderIndex(0, result);
+        return result;
+    }
     postorderHelper(root, result);
     return result;
 }
 
-std::vector<std::string> Tree::levelOrder() const {
-    std::vector<std::string> result;
-    if (root == nullptr) return result;
+void Tree::levelOrderHelper(TreeNode* node, std::vector<std::string>& result) const {
+    if (node == nullptr) return;
     
     std::queue<TreeNode*> q;
-    q.push(root);
+    q.push(node);
     
     while (!q.empty()) {
         TreeNode* current = q.front();
@@ -191,85 +422,304 @@ std::vector<std::string> Tree::levelOrder() const {
             q.push(current->right);
         }
     }
-    
-    return result;
 }
 
-int Tree::heightHelper(TreeNode* node) const {
-    if (node == nullptr) {
-        return -1;
+std::vector<std::string> Tree::levelOrder() const {
+    // Массив уже хранит узлы в порядке обхода в ширину
+    if (isImplicit()) {
+        return nodes;
     }
-    return 1 + std::max(heightHelper(node->left), heightHelper(node->right));
+    
+    std::vector<std::string> result;
+    levelOrderHelper(root, result);
+    return result;
 }
 
-int Tree::height() const {
-    return heightHelper(root);
+Tree::NodeRef Tree::rootRef() const {
+    if (isImplicit()) {
+        return nodes.empty() ? NodeRef{nullptr, NO_INDEX} : NodeRef{nullptr, 0};
+    }
+    return root == nullptr ? NodeRef{nullptr, NO_INDEX} : NodeRef{root, 0};
 }
 
-int Tree::sizeHelper(TreeNode* node) const {
-    if (node == nullptr) {
-        return 0;
+Tree::NodeRef Tree::leftOf(NodeRef ref) const {
+    if (isImplicit()) {
+        size_t child = 2 * ref.index + 1;
+        return child < nodes.size() ? NodeRef{nullptr, child} : NodeRef{nullptr, NO_INDEX};
     }
-    return 1 + sizeHelper(node->left) + sizeHelper(node->right);
+    return ref.node->left != nullptr ? NodeRef{ref.node->left, 0} : NodeRef{nullptr, NO_INDEX};
 }
 
-int Tree::size() const {
-    return sizeHelper(root);
+Tree::NodeRef Tree::rightOf(NodeRef ref) const {
+    if (isImplicit()) {
+        size_t child = 2 * ref.index + 2;
+        return child < nodes.size() ? NodeRef{nullptr, child} : NodeRef{nullptr, NO_INDEX};
+    }
+    return ref.node->right != nullptr ? NodeRef{ref.node->right, 0} : NodeRef{nullptr, NO_INDEX};
 }
 
-bool Tree::isFullHelper(TreeNode* node) const {
-    if (node == nullptr) {
-        return true;
-    }
+Tree::const_iterator::const_iterator(const Tree* owner, TraversalOrder traversalOrder)
+    : tree(owner),
+      order(traversalOrder),
+      current(nullRef()),
+      pending(nullRef()),
+      lastVisited(nullRef()) {
     
-    // Лист
-    if (node->left == nullptr && node->right == nullptr) {
-        return true;
-    }
+    NodeRef start = tree->rootRef();
+    if (isNull(start)) return;
     
-    // Узел с двумя потомками
-    if (node->left != nullptr && node->right != nullptr) {
-        return isFullHelper(node->left) && isFullHelper(node->right);
+    // Путь от корня не длиннее высоты + 1: стек выделяется один раз
+    if (order != TraversalOrder::LevelOrder) {
+        stack.reserve(tree->height() + 1);
     }
     
-    // Узел с одним потомком
-    return false;
+    switch (order) {
+        case TraversalOrder::Preorder:
+            stack.push_back(start);
+            break;
+        case TraversalOrder::Inorder:
+        case TraversalOrder::Postorder:
+            pending = start;
+            break;
+        case TraversalOrder::LevelOrder:
+            // Массив неявного дерева уже лежит в порядке обхода в ширину
+            if (tree->isImplicit()) {
+                current = start;
+                return;
+            }
+            frontier.push(start);
+            break;
+    }
+    advance();
 }
-bool Tree::isFullBinaryTree() const {
-    return isFullHelper(root);
+
+void Tree::const_iterator::advance() {
+    switch (order) {
+        case TraversalOrder::Preorder: {
+            if (stack.empty()) {
+                current = nullRef();
+                return;
+            }
+            current = stack.back();
+            stack.pop_back();
+            NodeRef right = tree->rightOf(current);
+            NodeRef left = tree->leftOf(current);
+            if (!isNull(right)) {
+                stack.push_back(right);
+            }
+            if (!isNull(left)) {
+                stack.push_back(left);
+            }
+            return;
+        }
+        
+        case TraversalOrder::Inorder:
+            // Спускаемся по левой ветви, запоминая путь
+            while (!isNull(pending)) {
+                stack.push_back(pending);
+                pending = tree->leftOf(pending);
+            }
+            if (stack.empty()) {
+                current = nullRef();
+                return;
+            }
+            current = stack.back();
+            stack.pop_back();
+            pending = tree->rightOf(current);
+            return;
+        
+        case TraversalOrder::Postorder:
+            while (true) {
+                while (!isNull(pending)) {
+                    stack.push_back(pending);
+                    pending = tree->leftOf(pending);
+                }
+                if (stack.empty()) {
+                    current = nullRef();
+                    return;
+                }
+                
+                // Узел выдаётся, когда его правое поддерево уже пройдено
+                NodeRef top = stack.back();
+                NodeRef right = tree->rightOf(top);
+                if (!isNull(right) && right != lastVisited) {
+                    pending = right;
+                } else {
+                    current = top;
+                    lastVisited = top;
+                    stack.pop_back();
+                    return;
+                }
+            }
+        
+        case TraversalOrder::LevelOrder:
+            if (tree->isImplicit()) {
+                size_t next = current.index + 1;
+                current = next < tree->nodes.size() ? NodeRef{nullptr, next} : nullRef();
+                return;
+            }
+            if (frontier.empty()) {
+                current = nullRef();
+                return;
+            }
+            current = frontier.front();
+            frontier.pop();
+            if (current.node->left != nullptr) {
+                frontier.push(NodeRef{current.node->left, 0});
+            }
+            if (current.node->right != nullptr) {
+                frontier.push(NodeRef{current.node->right, 0});
+            }
+            return;
+    }
+}
+
+Tree::const_iterator Tree::begin(TraversalOrder order) const {
+    return const_iterator(this, order);
 }
 
+Tree::const_iterator Tree::end() const {
+    return const_iterator(this);
+}
 
+Tree::Traversal Tree::traverse(TraversalOrder order) const {
+    return Traversal(this, order);
+}
 
-int Tree::countNodesHelper(TreeNode* node) const {
-    if (node == nullptr) return 0;
-    return 1 + countNodesHelper(node->left) + countNodesHelper(node->right);
+int Tree::heightHelper(TreeNode* node) const {
+    if (node == nullptr) {
+        return -1;
+    }
+    return node->height;
 }
 
-bool Tree::isCompleteHelper(TreeNode* node, int index, int nodeCount) const {
-    if (node == nullptr) return true;
+bool Tree::updateNode(TreeNode* node) {
+    // У отсутствующего потомка высота -1 и все свойства формы выполнены
+    int leftHeight = -1, rightHeight = -1;
+    unsigned leftShape = SHAPE_ALL, rightShape = SHAPE_ALL;
+    if (node->left != nullptr) {
+        leftHeight = node->left->height;
+        leftShape = node->left->shape;
+    }
+    if (node->right != nullptr) {
+        rightHeight = node->right->height;
+        rightShape = node->right->shape;
+    }
     
-    if (index >= nodeCount) return false;
+    int height = 1 + std::max(leftHeight, rightHeight);
     
-    return isCompleteHelper(node->left, 2 * index + 1, nodeCount) &&
-           isCompleteHelper(node->right, 2 * index + 2, nodeCount);
+    // Признаки считаются без ветвлений: сравнения высот на пути вставки
+    // непредсказуемы, и переходы по ним заметно замедляли бы вставку.
+    // Полное: у каждого узла 0 или 2 потомка
+    unsigned both = leftShape & rightShape;
+    unsigned sameHeight = leftHeight == rightHeight;
+    unsigned leftTaller = leftHeight == rightHeight + 1;
+    unsigned full = ((node->left == nullptr) == (node->right == nullptr)) & both & SHAPE_FULL;
+    
+    // Совершенное: оба поддерева совершенные и одной высоты
+    unsigned perfect = sameHeight & (both >> 2);
+    
+    // Завершённое: либо левое поддерево совершенное, а правое завершённое той же
+    // высоты, либо левое завершённое на уровень выше совершенного правого
+    unsigned complete = (sameHeight & (leftShape >> 2) & (rightShape >> 1)) |
+                        (leftTaller & (leftShape >> 1) & (rightShape >> 2));
+    
+    unsigned char shape = full | ((complete & 1) << 1) | ((perfect & 1) << 2);
+    if (node->height == height && node->shape == shape) {
+        return false;
+    }
+    node->height = height;
+    node->shape = shape;
+    return true;
+}
+
+int Tree::height() const {
+    // Высота полного дерева из n узлов — floor(log2(n))
+    if (isImplicit()) {
+        int h = -1;
+        for (size_t n = nodes.size(); n > 0; n >>= 1) {
+            h++;
+        }
+        return h;
+    }
+    return heightHelper(root);
+}
+
+int Tree::size() const {
+    if (isImplicit()) {
+        return nodes.size();
+    }
+    return nodeCount;
+}
+
+bool Tree::isFullBinaryTree() const {
+    // В полном дереве единственный узел с одним потомком появляется
+    // при чётном числе узлов
+    if (isImplicit()) {
+        return nodes.size() % 2 == 1 || nodes.empty();
+    }
+    return root == nullptr || (root->shape & SHAPE_FULL) != 0;
 }
 
 bool Tree::isCompleteBinaryTree() const {
-    int nodeCount = countNodesHelper(root);
-    return isCompleteHelper(root, 0, nodeCount);
+    // Неявное дерево полное по построению
+    if (isImplicit()) {
+        return true;
+    }
+    
+    return root == nullptr || (root->shape & SHAPE_COMPLETE) != 0;
 }
 
 bool Tree::isPerfectBinaryTree() const {
-    int h = height();
-    int expectedNodes = (1 << (h + 1)) - 1; // 2^(h+1) - 1
-    return size() == expectedNodes;
+    // Совершенное дерево содержит 2^(h+1) - 1 узлов
+    if (isImplicit()) {
+        size_t n = nodes.size();
+        return ((n + 1) & n) == 0;
+    }
+    
+    return root == nullptr || (root->shape & SHAPE_PERFECT) != 0;
 }
 
 void Tree::printTreeHelper(TreeNode* node, int depth, bool isLeft) const {
-    if (node == nullptr) return;
+    // Обратный симметричный обход: правое поддерево, узел, левое поддерево
+    struct Frame {
+        TreeNode* node;
+        int depth;
+        bool isLeft;
+    };
+    
+    std::vector<Frame> stack;
+    Frame current = {node, depth, isLeft};
+    
+    while (current.node != nullptr || !stack.empty()) {
+        while (current.node != nullptr) {
+            stack.push_back(current);
+            current = {current.node->right, current.depth + 1, false};
+        }
+        
+        Frame top = stack.back();
+        stack.pop_back();
+        
+        std::string indent;
+        for (int i = 0; i < top.depth; i++) {
+            indent += "    ";
+        }
+        
+        std::cout << indent;
+        if (top.depth > 0) {
+            std::cout << (top.isLeft ? "└── " : "┌── ");
+        }
+        
+        std::cout << top.node->data << std::endl;
+        
+        current = {top.node->left, top.depth + 1, true};
+    }
+}
+
+void Tree::printTreeIndex(size_t index, int depth, bool isLeft) const {
+    if (index >= nodes.size()) return;
     
-    printTreeHelper(node->right, depth + 1, false);
+    printTreeIndex(2 * index + 2, depth + 1, false);
     
     std::string indent;
     for (int i = 0; i < depth; i++) {
@@ -281,30 +731,23 @@ void Tree::printTreeHelper(TreeNode* node, int depth, bool isLeft) const {
         std::cout << (isLeft ? "└── " : "┌── ");
     }
     
-    std::cout << node->data << std::endl;
+    std::cout << nodes[index] << std::endl;
     
-    printTreeHelper(node->left, depth + 1, true);
+    printTreeIndex(2 * index + 1, depth + 1, true);
 }
 
 void Tree::printTree() const {
-    if (root == nullptr) {
+    if (isEmpty()) {
         std::cout << "Tree is empty" << std::endl;
         return;
     }
     
     std::cout << "Binary Tree Structure:" << std::endl;
-    printTreeHelper(root);
-}
-
-void Tree::serializeHelper(TreeNode* node, std::vector<std::string>& result) const {
-    if (node == nullptr) {
-        result.push_back("NULL");
-        return;
+    if (isImplicit()) {
+        printTreeIndex(0);
+    } else {
+        printTreeHelper(root);
     }
-    
-    result.push_back(node->data);
-    serializeHelper(node->left, result);
-    serializeHelper(node->right, result);
 }
 
 void Tree::serializeToFile(const std::string& filename) const {
@@ -313,47 +756,189 @@ void Tree::serializeToFile(const std::string& filename) const {
         throw std::runtime_error("Cannot open file for writing");
     }
     
-    std::vector<std::string> serializedData;
-    serializeHelper(root, serializedData);
+    // Формат файла общий для обоих режимов хранения. Первый проход
+    // собирает форму и длины значений, второй пишет сами значения
+    uint32_t count = size();
+    std::vector<unsigned char> shapeBits((2 * static_cast<size_t>(count) + 7) / 8, 0);
+    std::string lengths;
+    uint64_t blobSize = 0;
+    size_t bit = 0;
+    for (const_iterator it = begin(TraversalOrder::LevelOrder); it != end(); ++it) {
+        NodeRef ref = it.current;
+        if (!isNull(leftOf(ref))) {
+            shapeBits[bit / 8] |= 1 << (bit % 8);
+        }
+        bit++;
+        if (!isNull(rightOf(ref))) {
+            shapeBits[bit / 8] |= 1 << (bit % 8);
+        }
+        bit++;
+        
+        writeVarint(lengths, dataOf(ref).size());
+        blobSize += dataOf(ref).size();
+    }
     
-    int dataSize = serializedData.size();
-    file.write(reinterpret_cast<const char*>(&dataSize), sizeof(dataSize));
+    uint64_t lengthsSize = lengths.size();
+    file.write(reinterpret_cast<const char*>(&TREE_MAGIC), sizeof(TREE_MAGIC));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    file.write(reinterpret_cast<const char*>(&lengthsSize), sizeof(lengthsSize));
+    file.write(reinterpret_cast<const char*>(&blobSize), sizeof(blobSize));
+    file.write(reinterpret_cast<const char*>(shapeBits.data()), shapeBits.size());
+    file.write(lengths.data(), lengths.size());
     
-    for (const auto& str : serializedData) {
-        int strSize = str.size();
-        file.write(reinterpret_cast<const char*>(&strSize), sizeof(strSize));
-        file.write(str.c_str(), strSize);
-    }
+    forEach(TraversalOrder::LevelOrder, [&file](const std::string& value) {
+        file.write(value.data(), value.size());
+        return true;
+    });
     
+    if (!file) {
+        throw std::runtime_error("Cannot write tree file");
+    }
     file.close();
 }
 
+void Tree::readCompact(std::istream& file) {
+    uint32_t count = 0;
+    uint64_t lengthsSize = 0;
+    uint64_t blobSize = 0;
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    file.read(reinterpret_cast<char*>(&lengthsSize), sizeof(lengthsSize));
+    file.read(reinterpret_cast<char*>(&blobSize), sizeof(blobSize));
+    // Длина каждого значения занимает от 1 до 5 байт
+    if (!file || lengthsSize < count || lengthsSize > 5 * static_cast<uint64_t>(count)) {
+        throw std::runtime_error("Invalid tree file");
+    }
+    // Размеры из заголовка сверяются с длиной файла до выделения памяти:
+    // испорченный заголовок не должен приводить к выделению гигабайт
+    const uint64_t shapeSize = (2 * static_cast<uint64_t>(count) + 7) / 8;
+    const uint64_t available = remainingBytes(file);
+    if (lengthsSize > available || blobSize > available ||
+        shapeSize + lengthsSize + blobSize > available) {
+        throw std::runtime_error("Invalid tree file");
+    }
+    
+    std::vector<unsigned char> shapeBits(shapeSize);
+    std::string lengths(lengthsSize, '\0');
+    file.read(reinterpret_cast<char*>(shapeBits.data()), shapeBits.size());
+    file.read(&lengths[0], lengths.size());
+    if (!file) {
+        throw std::runtime_error("Invalid tree file");
+    }
+    
+    // Значения читаются из файла сразу в строки узлов, без промежуточного массива
+    size_t lengthPosition = 0;
+    uint64_t remaining = blobSize;
+    auto readValue = [&](std::string& value) {
+        uint32_t length = 0;
+        if (!readVarint(lengths, lengthPosition, length) || length > remaining) {
+            throw std::runtime_error("Invalid tree file");
+        }
+        remaining -= length;
+        value.resize(length);
+        file.read(&value[0], length);
+        if (!file) {
+            throw std::runtime_error("Invalid tree file");
+        }
+    };
+    
+    // Неявному дереву форма не нужна: значения уже идут в порядке обхода в ширину
+    if (isImplicit()) {
+        try {
+            nodes.resize(count);
+            for (auto& value : nodes) {
+                readValue(value);
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+        return;
+    }
+    
+    if (count == 0) return;
+    
+    // Узлы в порядке обхода в ширину: потомки очередного родителя —
+    // следующие прочитанные узлы
+    std::vector<TreeNode*> order;
+    order.reserve(count);
+    try {
+        root = createNode(std::string());
+        order.push_back(root);
+        nodeCount++;
+        readValue(root->data);
+        
+        for (size_t parent = 0; parent < order.size(); parent++) {
+            for (size_t side = 0; side < 2; side++) {
+                size_t bit = 2 * parent + side;
+                if ((shapeBits[bit / 8] >> (bit % 8) & 1) == 0) continue;
+                if (order.size() == count) {
+                    throw std::runtime_error("Invalid tree file");
+                }
+                
+                TreeNode* child = createNode(std::string());
+                (side == 0 ? order[parent]->left : order[parent]->right) = child;
+                order.push_back(child);
+                nodeCount++;
+                readValue(child->data);
+            }
+        }
+        
+        if (order.size() != count) {
+            throw std::runtime_error("Invalid tree file");
+        }
+    } catch (...) {
+        clear();
+        throw;
+    }
+    
+    // В обратном порядке потомки пересчитываются раньше родителей
+    for (size_t i = order.size(); i-- > 0;) {
+        updateNode(order[i]);
+    }
+}
+
 Tree::TreeNode* Tree::deserializeHelper(const std::vector<std::string>& data, int& index) {
-    if (index >= data.size() || data[index] == "NULL") {
+    if (index >= static_cast<int>(data.size()) || data[index] == "NULL") {
         index++;
         return nullptr;
     }
     
-    TreeNode* node = new TreeNode(data[index]);
+    TreeNode* node = createNode(data[index]);
+    nodeCount++;
     index++;
     
-    node->left = deserializeHelper(data, index);
-    node->right = deserializeHelper(data, index);
+    // В стеке узлы, у которых ещё заполняются потомки, и число уже
+    // заполненных (0 — следующий элемент идёт в левого потомка, 1 — в правого)
+    std::vector<std::pair<TreeNode*, int>> stack(1, std::make_pair(node, 0));
+    while (!stack.empty()) {
+        TreeNode* parent = stack.back().first;
+        int filled = stack.back().second;
+        
+        // Оба поддерева прочитаны — высота узла известна
+        if (filled == 2) {
+            updateNode(parent);
+            stack.pop_back();
+            continue;
+        }
+        
+        TreeNode* child = nullptr;
+        if (index < static_cast<int>(data.size()) && data[index] != "NULL") {
+            child = createNode(data[index]);
+            nodeCount++;
+        }
+        index++;
+        
+        (filled == 0 ? parent->left : parent->right) = child;
+        stack.back().second++;
+        if (child != nullptr) {
+            stack.push_back(std::make_pair(child, 0));
+        }
+    }
     
     return node;
 }
 
-void Tree::deserializeFromFile(const std::string& filename) {
-    std::ifstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
-        throw std::runtime_error("Cannot open file for reading");
-    }
-    
-    clear();
-    
-    int dataSize;
-    file.read(reinterpret_cast<char*>(&dataSize), sizeof(dataSize));
-    
+void Tree::readLegacy(std::istream& file, int dataSize) {
     std::vector<std::string> serializedData;
     for (int i = 0; i < dataSize; i++) {
         int strSize;
@@ -367,5 +952,218 @@ void Tree::deserializeFromFile(const std::string& filename) {
     int index = 0;
     root = deserializeHelper(serializedData, index);
     
+    // Неявное дерево раскладывает узлы файла в порядке обхода в ширину.
+    // Форма сохраняется, если в файле было полное дерево
+    if (isImplicit()) {
+        levelOrderHelper(root, nodes);
+        destroyTree(root);
+        root = nullptr;
+        nodeCount = 0;
+    }
+}
+
+void Tree::deserializeFromFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for reading");
+    }
+    
+    clear();
+    
+    // Файлы старого формата начинаются с числа строк, а не с сигнатуры
+    uint32_t magic = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    if (magic == TREE_MAGIC) {
+        readCompact(file);
+    } else {
+        readLegacy(file, static_cast<int>(magic));
+    }
+    
     file.close();
+}
+
+unsigned Tree::resolveThreads(unsigned threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    return std::max(1u, threads);
+}
+
+void Tree::runParallel(unsigned threads, size_t tasks, const std::function<void(size_t)>& task) {
+    // Задачи раздаются по одной через общий счётчик. Первое исключение
+    // из рабочего потока пробрасывается вызывающему после join
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&]() {
+        try {
+            for (size_t i = next++; i < tasks; i = next++) {
+                task(i);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            next = tasks;
+        }
+    };
+    
+    std::vector<std::thread> workers;
+    size_t extra = std::min<size_t>(threads, tasks);
+    try {
+        workers.reserve(extra);
+        for (size_t i = 1; i < extra; i++) {
+            workers.emplace_back(worker);
+        }
+    } catch (...) {
+        // Поток не запустился: уже запущенные останавливаются и дожидаются
+        next = tasks;
+        for (auto& thread : workers) {
+            thread.join();
+        }
+        throw;
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void Tree::splitTop(size_t minParts, std::vector<NodeRef>& upper, std::vector<NodeRef>& parts) const {
+    NodeRef start = rootRef();
+    if (isNull(start)) return;
+    parts.push_back(start);
+    
+    // Фронт опускается на уровень, пока поддеревьев меньше нужного.
+    // Глубина спуска ограничена: вырожденную цепочку так не разделить,
+    // и обход её вызывающим потоком был бы последовательным
+    const int maxDepth = 32;
+    for (int depth = 0; depth < maxDepth && !parts.empty() && parts.size() < minParts; depth++) {
+        std::vector<NodeRef> next;
+        for (NodeRef ref : parts) {
+            upper.push_back(ref);
+            NodeRef left = leftOf(ref);
+            NodeRef right = rightOf(ref);
+            if (!isNull(left)) {
+                next.push_back(left);
+            }
+            if (!isNull(right)) {
+                next.push_back(right);
+            }
+        }
+        parts.swap(next);
+    }
+}
+
+Tree::TreeNode* Tree::buildSubtree(const std::vector<std::string>& values, size_t index,
+                                   void* const* slots) {
+    // Глубина рекурсии — высота полного дерева, то есть O(log n)
+    if (index >= values.size()) {
+        return nullptr;
+    }
+    
+    TreeNode* node = slots != nullptr ? new (slots[index]) TreeNode(values[index])
+                                      : new TreeNode(values[index]);
+    // При ошибке узел и уже построенное левое поддерево освобождаются здесь же
+    try {
+        node->left = buildSubtree(values, 2 * index + 1, slots);
+        node->right = buildSubtree(values, 2 * index + 2, slots);
+    } catch (...) {
+        if (slots != nullptr) {
+            destructTree(node);
+        } else {
+            destroyTree(node);
+        }
+        throw;
+    }
+    updateNode(node);
+    return node;
+}
+
+void Tree::destructTree(TreeNode* node) {
+    if (node == nullptr) return;
+    
+    std::vector<TreeNode*> stack(1, node);
+    while (!stack.empty()) {
+        TreeNode* current = stack.back();
+        stack.pop_back();
+        if (current->left != nullptr) {
+            stack.push_back(current->left);
+        }
+        if (current->right != nullptr) {
+            stack.push_back(current->right);
+        }
+        current->~TreeNode();
+    }
+}
+
+void Tree::buildFrom(const std::vector<std::string>& values, unsigned threads) {
+    clear();
+    if (isImplicit()) {
+        nodes = values;
+        return;
+    }
+    if (values.empty()) return;
+    
+    // Уровень, на котором поддеревьев заметно больше, чем потоков:
+    // его узлы [first, first + width) строятся параллельно, а узлы выше
+    // достраивает вызывающий поток
+    threads = resolveThreads(threads);
+    size_t first = 0, width = 1;
+    if (threads > 1) {
+        while (width < 4 * static_cast<size_t>(threads) && first + width < values.size()) {
+            first += width;
+            width *= 2;
+        }
+    }
+    
+    // Пул не потокобезопасен: блоки под все узлы выделяются заранее,
+    // по блоку на индекс, а потоки только конструируют узлы в них
+    std::vector<void*> slots;
+    if (pool) {
+        slots.resize(values.size());
+        for (void*& slot : slots) {
+            slot = pool->allocate();
+        }
+    }
+    void* const* slotData = pool ? slots.data() : nullptr;
+    
+    size_t last = std::min(first + width, values.size());
+    std::vector<TreeNode*> built(last, nullptr);
+    try {
+        runParallel(threads, last - first, [&](size_t i) {
+            built[first + i] = buildSubtree(values, first + i, slotData);
+        });
+        
+        // Снизу вверх, так что потомки уже готовы. Присоединённый потомок
+        // убирается из built, и при ошибке каждый узел освобождается один раз
+        for (size_t i = first; i-- > 0;) {
+            TreeNode* node = slotData != nullptr ? new (slotData[i]) TreeNode(values[i])
+                                                 : new TreeNode(values[i]);
+            for (size_t child = 2 * i + 1; child <= 2 * i + 2 && child < last; child++) {
+                (child == 2 * i + 1 ? node->left : node->right) = built[child];
+                built[child] = nullptr;
+            }
+            updateNode(node);
+            built[i] = node;
+        }
+    } catch (...) {
+        // Рабочие потоки уже завершены. Заготовленные блоки пула, в которых
+        // узел так и не был построен, возвращаются вместе с плитами
+        for (TreeNode* node : built) {
+            destroyTree(node);
+        }
+        if (pool) {
+            pool->release();
+        }
+        throw;
+    }
+    
+    root = built[0];
+    nodeCount = values.size();
 }
\ No newline at end of file
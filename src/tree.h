@@ -3,22 +3,84 @@
 
 #include <string>
 #include <vector>
+#include <queue>
+#include <cstddef>
+#include <iterator>
+#include <iosfwd>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include "node_pool.h"
 
 class Tree {
+public:
+    // Способ хранения: Linked — узлы с указателями на потомков,
+    // Implicit — полное бинарное дерево в одном массиве без указателей,
+    // потомки узла i лежат в ячейках 2i+1 и 2i+2
+    enum class StorageMode { Linked, Implicit };
+    
+    // Порядок обхода для итераторов и forEach
+    enum class TraversalOrder { Preorder, Inorder, Postorder, LevelOrder };
+    
+    class const_iterator;
+    class Traversal;
+
 private:
+    // Свойства формы поддерева: полное, завершённое, совершенное
+    static constexpr unsigned char SHAPE_FULL = 1;
+    static constexpr unsigned char SHAPE_COMPLETE = 2;
+    static constexpr unsigned char SHAPE_PERFECT = 4;
+    static constexpr unsigned char SHAPE_ALL = SHAPE_FULL | SHAPE_COMPLETE | SHAPE_PERFECT;
+    
     struct TreeNode {
         std::string data;
         TreeNode* left;
         TreeNode* right;
+        // Высота поддерева с корнем в этом узле (у листа 0) и свойства его
+        // формы (маска SHAPE_*). Пересчитываются снизу вверх при вставке,
+        // удалении и чтении из файла, поэтому запросы к корню стоят O(1).
+        // Маска занимает выравнивание после высоты и не увеличивает узел
+        int height;
+        unsigned char shape;
         
-        TreeNode(const std::string& value) 
-            : data(value), left(nullptr), right(nullptr) {}
+        TreeNode(const std::string& value)
+            : data(value), left(nullptr), right(nullptr), height(0), shape(SHAPE_ALL) {}
     };
-     
+    
     TreeNode* root;
+    // Число узлов связного дерева
+    int nodeCount;
+    StorageMode storageMode;
+    // Значения в порядке обхода в ширину (режим Implicit)
+    std::vector<std::string> nodes;
+    // Пул узлов (только в режиме NodeAllocation::Pooled)
+    std::unique_ptr<NodePool> pool;
     
-    // Вспомогательные рекурсивные методы
-    TreeNode* insertHelper(TreeNode* node, const std::string& value);
+    // Ссылка на узел, общая для обоих режимов хранения: указатель на узел
+    // (Linked) или индекс в массиве (Implicit). Пустая ссылка — {nullptr, NO_INDEX}
+    static constexpr size_t NO_INDEX = static_cast<size_t>(-1);
+    struct NodeRef {
+        const TreeNode* node;
+        size_t index;
+        
+        bool operator==(const NodeRef& other) const {
+            return node == other.node && index == other.index;
+        }
+        bool operator!=(const NodeRef& other) const { return !(*this == other); }
+    };
+    
+    NodeRef rootRef() const;
+    NodeRef leftOf(NodeRef ref) const;
+    NodeRef rightOf(NodeRef ref) const;
+    static bool isNull(NodeRef ref) { return ref.index == NO_INDEX; }
+    const std::string& dataOf(NodeRef ref) const {
+        return isImplicit() ? nodes[ref.index] : ref.node->data;
+    }
+    
+    // Вспомогательные методы
+    TreeNode* createNode(const std::string& value);
+    void destroyNode(TreeNode* node);
+    TreeNode* insertHelper(TreeNode* node, const std::string& value, bool& changed);
     TreeNode* searchHelper(TreeNode* node, const std::string& value) const;
     TreeNode* findMin(TreeNode* node) const;
     TreeNode* removeHelper(TreeNode* node, const std::string& value);
@@ -26,18 +88,38 @@ private:
     void inorderHelper(TreeNode* node, std::vector<std::string>& result) const;
     void preorderHelper(TreeNode* node, std::vector<std::string>& result) const;
     void postorderHelper(TreeNode* node, std::vector<std::string>& result) const;
+    void levelOrderHelper(TreeNode* node, std::vector<std::string>& result) const;
     int heightHelper(TreeNode* node) const;
-    int sizeHelper(TreeNode* node) const;
-    bool isFullHelper(TreeNode* node) const;
-    bool isCompleteHelper(TreeNode* node, int index, int nodeCount) const;
-    int countNodesHelper(TreeNode* node) const;
-    void serializeHelper(TreeNode* node, std::vector<std::string>& result) const;
+    // Пересчёт высоты и формы узла по потомкам; false, если ничего не изменилось
+    bool updateNode(TreeNode* node);
     TreeNode* deserializeHelper(const std::vector<std::string>& data, int& index);
+    void readCompact(std::istream& file);
+    void readLegacy(std::istream& file, int dataSize);
     void printTreeHelper(TreeNode* node, int depth = 0, bool isLeft = false) const;
     
+    // Вспомогательные методы режима Implicit (узел задаётся индексом в массиве)
+    void inorderIndex(size_t index, std::vector<std::string>& result) const;
+    void preorderIndex(size_t index, std::vector<std::string>& result) const;
+    void postorderIndex(size_t index, std::vector<std::string>& result) const;
+    void printTreeIndex(size_t index, int depth = 0, bool isLeft = false) const;
+    bool isImplicit() const { return storageMode == StorageMode::Implicit; }
+    
+    // Параллельные операции: верхние уровни дерева снимает вызывающий поток,
+    // поддеревья под ними разбирают рабочие потоки
+    static unsigned resolveThreads(unsigned threads);
+    static void runParallel(unsigned threads, size_t tasks, const std::function<void(size_t)>& task);
+    void splitTop(size_t minParts, std::vector<NodeRef>& upper, std::vector<NodeRef>& parts) const;
+    template<typename Visitor>
+    bool forEachInSubtree(NodeRef start, Visitor& visitor) const;
+    TreeNode* buildSubtree(const std::vector<std::string>& values, size_t index, void* const* slots);
+    // Деструкторы узлов поддерева без возврата блоков в пул: годится
+    // для рабочих потоков, блоки потом отдаёт pool->release()
+    static void destructTree(TreeNode* node);
+
 public:
     // Конструкторы и деструктор
-    Tree();
+    explicit Tree(StorageMode mode = StorageMode::Linked,
+                  NodeAllocation allocation = NodeAllocation::Heap);
     ~Tree();
     
     // Запрет копирования
@@ -55,6 +137,38 @@ public:
     std::vector<std::string> postorder() const;
     std::vector<std::string> levelOrder() const;
     
+    // Ленивые обходы без копирования значений: итератор хранит только путь
+    // от корня (O(высоты) памяти, место под него резервируется один раз).
+    // Обход в ширину связного дерева хранит текущий фронт — O(ширины), до
+    // n/2 узлов: обход по уровням с одним путём от корня стоил бы O(n·h)
+    // времени и на вырожденном дереве из файла становился бы квадратичным.
+    // Постфиксный ++ копирует это состояние, поэтому в циклах нужен
+    // префиксный. Дерево нельзя изменять, пока итератор используется
+    const_iterator begin(TraversalOrder order = TraversalOrder::Inorder) const;
+    const_iterator end() const;
+    Traversal traverse(TraversalOrder order) const;
+    
+    // Вызывает visitor(const std::string&) для узлов в заданном порядке.
+    // Обход прекращается, как только посетитель вернёт false
+    template<typename Visitor>
+    void forEach(TraversalOrder order, Visitor visitor) const;
+    
+    // Параллельные операции. threads == 0 — по числу ядер.
+    // Построение полного дерева, в котором values идут в порядке обхода
+    // в ширину (та же раскладка, что у режима Implicit); прежнее
+    // содержимое удаляется. Поддеревья строятся в разных потоках
+    void buildFrom(const std::vector<std::string>& values, unsigned threads = 0);
+    
+    // Функции вызываются из нескольких потоков одновременно и должны быть
+    // потокобезопасны; порядок посещения узлов не определён, поэтому
+    // reduce должна быть ассоциативной и коммутативной
+    template<typename Predicate>
+    size_t parallelCount(Predicate predicate, unsigned threads = 0) const;
+    template<typename Predicate>
+    bool parallelAny(Predicate predicate, unsigned threads = 0) const;
+    template<typename T, typename Map, typename Reduce>
+    T parallelReduce(T identity, Map map, Reduce reduce, unsigned threads = 0) const;
+    
     // Проверки свойств
     bool isFullBinaryTree() const;
     bool isCompleteBinaryTree() const;
@@ -63,16 +177,194 @@ public:
     // Утилиты
     int height() const;
     int size() const;
-    bool isEmpty() const { return root == nullptr; }
+    bool isEmpty() const { return root == nullptr && nodes.empty(); }
+    StorageMode getStorageMode() const { return storageMode; }
+    // Pooled только в режиме Linked: неявному дереву пул не нужен
+    NodeAllocation getAllocation() const { return pool ? NodeAllocation::Pooled : NodeAllocation::Heap; }
     void clear();
     void printTree() const;
     
-    // Сериализация
+    // Сериализация. Пустые потомки кодируются битами формы, а не строками,
+    // так что любое значение (в том числе "NULL") читается обратно как есть.
+    // Файлы старого формата со строками "NULL" по-прежнему читаются
     void serializeToFile(const std::string& filename) const;
     void deserializeFromFile(const std::string& filename);
     
-    // Для тестирования
+    // Для тестирования (в режиме Implicit отдельных узлов нет, возвращает nullptr)
     const TreeNode* getRoot() const { return root; }
 };
 
+// Однонаправленный итератор по значениям дерева в заданном порядке
+class Tree::const_iterator {
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef std::string value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const std::string* pointer;
+    typedef const std::string& reference;
+    
+    const_iterator() : tree(nullptr), order(TraversalOrder::Inorder), current(nullRef()) {}
+    
+    reference operator*() const { return tree->dataOf(current); }
+    pointer operator->() const { return &tree->dataOf(current); }
+    
+    const_iterator& operator++() {
+        advance();
+        return *this;
+    }
+    const_iterator operator++(int) {
+        const_iterator previous = *this;
+        advance();
+        return previous;
+    }
+    
+    // Итераторы разных деревьев не равны, даже если оба в конце обхода
+    bool operator==(const const_iterator& other) const {
+        return tree == other.tree && current == other.current;
+    }
+    bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+private:
+    friend class Tree;
+    
+    const Tree* tree;
+    TraversalOrder order;
+    // Текущий узел (пустая ссылка — конец обхода)
+    NodeRef current;
+    // Путь от корня: правые поддеревья, ждущие обхода (прямой порядок),
+    // или предки текущего узла (симметричный и обратный)
+    std::vector<NodeRef> stack;
+    // Следующее поддерево, по левой ветви которого нужно спуститься
+    NodeRef pending;
+    // Последний выданный узел (обратный порядок)
+    NodeRef lastVisited;
+    // Фронт обхода в ширину для связного дерева
+    std::queue<NodeRef> frontier;
+    
+    static NodeRef nullRef() { return NodeRef{nullptr, NO_INDEX}; }
+    const_iterator(const Tree* owner, TraversalOrder traversalOrder);
+    // Конец обхода дерева owner
+    explicit const_iterator(const Tree* owner)
+        : tree(owner), order(TraversalOrder::Inorder), current(nullRef()),
+          pending(nullRef()), lastVisited(nullRef()) {}
+    void advance();
+};
+
+// Диапазон для range-based for: for (const auto& value : tree.traverse(order))
+class Tree::Traversal {
+public:
+    Traversal(const Tree* owner, TraversalOrder traversalOrder)
+        : tree(owner), order(traversalOrder) {}
+    
+    const_iterator begin() const { return tree->begin(order); }
+    const_iterator end() const { return tree->end(); }
+
+private:
+    const Tree* tree;
+    TraversalOrder order;
+};
+
+template<typename Visitor>
+void Tree::forEach(TraversalOrder order, Visitor visitor) const {
+    for (const_iterator it = begin(order); it != end(); ++it) {
+        if (!visitor(*it)) {
+            return;
+        }
+    }
+}
+
+template<typename Visitor>
+bool Tree::forEachInSubtree(NodeRef start, Visitor& visitor) const {
+    std::vector<NodeRef> stack(1, start);
+    while (!stack.empty()) {
+        NodeRef current = stack.back();
+        stack.pop_back();
+        if (!visitor(dataOf(current))) {
+            return false;
+        }
+        
+        NodeRef right = rightOf(current);
+        NodeRef left = leftOf(current);
+        if (!isNull(right)) {
+            stack.push_back(right);
+        }
+        if (!isNull(left)) {
+            stack.push_back(left);
+        }
+    }
+    return true;
+}
+
+template<typename T, typename Map, typename Reduce>
+T Tree::parallelReduce(T identity, Map map, Reduce reduce, unsigned threads) const {
+    threads = resolveThreads(threads);
+    std::vector<NodeRef> upper, parts;
+    // Поддеревьев больше, чем потоков: неравные по размеру части
+    // разбираются по мере освобождения потоков
+    splitTop(4 * threads, upper, parts);
+    
+    // Частичный итог каждой части в своей структуре (vector<bool> не годится)
+    struct Partial {
+        T value;
+    };
+    std::vector<Partial> partials(parts.size(), Partial{identity});
+    runParallel(threads, parts.size(), [&](size_t i) {
+        T accumulated = identity;
+        auto visitor = [&](const std::string& value) {
+            accumulated = reduce(accumulated, map(value));
+            return true;
+        };
+        forEachInSubtree(parts[i], visitor);
+        partials[i].value = accumulated;
+    });
+    
+    T result = identity;
+    for (NodeRef ref : upper) {
+        result = reduce(result, map(dataOf(ref)));
+    }
+    for (const Partial& partial : partials) {
+        result = reduce(result, partial.value);
+    }
+    return result;
+}
+
+template<typename Predicate>
+size_t Tree::parallelCount(Predicate predicate, unsigned threads) const {
+    return parallelReduce(static_cast<size_t>(0),
+                          [&predicate](const std::string& value) -> size_t {
+                              return predicate(value) ? 1 : 0;
+                          },
+                          [](size_t a, size_t b) { return a + b; }, threads);
+}
+
+template<typename Predicate>
+bool Tree::parallelAny(Predicate predicate, unsigned threads) const {
+    threads = resolveThreads(threads);
+    std::vector<NodeRef> upper, parts;
+    splitTop(4 * threads, upper, parts);
+    
+    for (NodeRef ref : upper) {
+        if (predicate(dataOf(ref))) {
+            return true;
+        }
+    }
+    
+    // Найденное совпадение останавливает остальные потоки
+    std::atomic<bool> found(false);
+    runParallel(threads, parts.size(), [&](size_t i) {
+        auto visitor = [&](const std::string& value) {
+            if (found.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            if (predicate(value)) {
+                found.store(true, std::memory_order_relaxed);
+                return false;
+            }
+            return true;
+        };
+        forEachInSubtree(parts[i], visitor);
+    });
+    return found.load();
+}
+
 #endif
\ No newline at end of file
@@ -5,16 +5,53 @@
 #include "../src/stack.h"
 #include "../src/queue.h"
 #include "../src/hash_table.h"
+#include "../src/concurrent_hash_table.h"
+#include "../src/concurrent_queue.h"
+#include "../src/mapped_hash_table.h"
 #include "../src/tree.h"
+#include "../src/ordered_tree.h"
+#include "../src/bplus_tree.h"
 #include <string>
 #include <vector>
 #include <random>
+#include <chrono>
+#include <algorithm>
+#include <map>
+#include <fstream>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// ==================== Allocation Counting ====================
+
+// Глобальный счётчик выделений памяти для бенчмарков, проверяющих,
+// что горячий путь не обращается к куче
+static std::atomic<size_t> allocationCount(0);
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
 
 // Генератор случайных строк
 std::string generateRandomString(int length) {
     static const char alphanum[] =
         "0123456789"
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZ" 
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
         "abcdefghijklmnopqrstuvwxyz";
     
     std::string result;
@@ -134,9 +171,10 @@ static void BM_SinglyListInsertFront(benchmark::State& state) {
 }
 BENCHMARK(BM_SinglyListInsertFront)->Range(8, 8<<10)->Complexity();
 
-static void BM_SinglyListSearch(benchmark::State& state) {
+// Поиск в обычном и развёрнутом списке
+static void BM_SinglyListSearch(benchmark::State& state, SinglyList::StorageMode mode) {
     const int size = state.range(0);
-    SinglyList list;
+    SinglyList list(mode);
     
     // Заполняем список
     for (int i = 0; i < size; ++i) {
@@ -154,7 +192,10 @@ static void BM_SinglyListSearch(benchmark::State& state) {
     
     state.SetComplexityN(size);
 }
-BENCHMARK(BM_SinglyListSearch)->Range(8, 8<<10)->Complexity();
+BENCHMARK_CAPTURE(BM_SinglyListSearch, linked, SinglyList::StorageMode::Linked)
+    ->Range(8, 8<<10)->Complexity();
+BENCHMARK_CAPTURE(BM_SinglyListSearch, unrolled, SinglyList::StorageMode::Unrolled)
+    ->Range(8, 8<<10)->Complexity();
 
 // ==================== Doubly Linked List Benchmarks ====================
 
@@ -177,9 +218,10 @@ static void BM_DoublyListInsertBack(benchmark::State& state) {
 }
 BENCHMARK(BM_DoublyListInsertBack)->Range(8, 8<<10)->Complexity();
 
-static void BM_DoublyListTraversal(benchmark::State& state) {
+// Полный обход обычного и развёрнутого списка
+static void BM_DoublyListTraversal(benchmark::State& state, DoublyList::StorageMode mode) {
     const int size = state.range(0);
-    DoublyList list;
+    DoublyList list(mode);
     
     // Заполняем список
     for (int i = 0; i < size; ++i) {
@@ -187,38 +229,93 @@ static void BM_DoublyListTraversal(benchmark::State& state) {
     }
     
     for (auto _ : state) {
-        // Просто измеряем время создания (в реальности нужен итератор)
-        benchmark::DoNotOptimize(list.getSize());
+        size_t totalLength = 0;
+        list.forEach([&totalLength](const std::string& value) {
+            totalLength += value.size();
+        });
+        benchmark::DoNotOptimize(totalLength);
     }
     
     state.SetComplexityN(size);
 }
-BENCHMARK(BM_DoublyListTraversal)->Range(8, 8<<10)->Complexity();
+BENCHMARK_CAPTURE(BM_DoublyListTraversal, linked, DoublyList::StorageMode::Linked)
+    ->Range(8, 8<<10)->Complexity();
+BENCHMARK_CAPTURE(BM_DoublyListTraversal, unrolled, DoublyList::StorageMode::Unrolled)
+    ->Range(8, 8<<10)->Complexity();
+
+// ==================== List Value Index Benchmarks ====================
+
+// Правка по значению в середине списка: insertAfter и removeValue по
+// случайному существующему значению. Без индекса (indexed = 0) обе
+// операции ищут узел обходом, с индексом — через хеш-таблицу; по размерам
+// видно, с какой длины список с индексом обгоняет обычный
+template<typename List>
+static void BM_ListValueEdit(benchmark::State& state) {
+    const int size = state.range(0);
+    List list;
+    list.setIndexed(state.range(1) != 0);
+    
+    std::vector<std::string> values;
+    for (int i = 0; i < size; ++i) {
+        values.push_back("element_" + std::to_string(i));
+        list.insertBack(values.back());
+    }
+    
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dis(0, size - 1);
+    const std::string inserted = "inserted";
+    
+    for (auto _ : state) {
+        list.insertAfter(values[dis(gen)], inserted);
+        list.removeValue(inserted);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK_TEMPLATE(BM_ListValueEdit, SinglyList)
+    ->ArgsProduct({{8, 64, 512, 4<<10, 32<<10}, {0, 1}});
+BENCHMARK_TEMPLATE(BM_ListValueEdit, DoublyList)
+    ->ArgsProduct({{8, 64, 512, 4<<10, 32<<10}, {0, 1}});
 
 // ==================== Stack Benchmarks ====================
 
-static void BM_StackPushPop(benchmark::State& state) {
+// Заполнение и опустошение стека в обоих режимах хранения. Стек
+// переиспользуется между итерациями, как рабочий список обхода в глубину,
+// поэтому после первой итерации массив режима Contiguous уже нужной
+// ёмкости. Значения длиннее буфера малых строк и перемещаются в стек
+// и из него; allocs_per_op — выделения памяти на пару push/pop
+static void BM_StackPushPop(benchmark::State& state, Stack::StorageMode mode) {
     const int num_operations = state.range(0);
+    Stack stack(mode);
     
+    std::vector<std::string> values;
+    for (int i = 0; i < num_operations; ++i) {
+        values.push_back("dfs_worklist_entry_" + std::to_string(i));
+    }
+    
+    size_t before = allocationCount.load(std::memory_order_relaxed);
     for (auto _ : state) {
-        state.PauseTiming();
-        Stack stack;
-        state.ResumeTiming();
-        
         for (int i = 0; i < num_operations; ++i) {
-            stack.push("element_" + std::to_string(i));
+            stack.push(std::move(values[i]));
         }
         
-        for (int i = 0; i < num_operations; ++i) {
-            benchmark::DoNotOptimize(stack.pop());
+        for (int i = num_operations - 1; i >= 0; --i) {
+            values[i] = stack.pop();
         }
         
-        benchmark::DoNotOptimize(stack);
+        benchmark::DoNotOptimize(values.data());
     }
+    size_t allocations = allocationCount.load(std::memory_order_relaxed) - before;
     
     state.SetComplexityN(num_operations);
+    state.SetItemsProcessed(state.iterations() * num_operations);
+    state.counters["allocs_per_op"] =
+        static_cast<double>(allocations) / (state.iterations() * num_operations);
 }
-BENCHMARK(BM_StackPushPop)->Range(8, 8<<10)->Complexity();
+BENCHMARK_CAPTURE(BM_StackPushPop, linked, Stack::StorageMode::Linked)
+    ->Range(8, 8<<10)->Complexity();
+BENCHMARK_CAPTURE(BM_StackPushPop, contiguous, Stack::StorageMode::Contiguous)
+    ->Range(8, 8<<10)->Complexity();
 
 // ==================== Queue Benchmarks ====================
 
@@ -245,6 +342,32 @@ static void BM_QueueEnqueueDequeue(benchmark::State& state) {
 }
 BENCHMARK(BM_QueueEnqueueDequeue)->Range(8, 8<<10)->Complexity();
 
+// Установившийся режим диспетчера задач: очередь держит depth элементов,
+// каждая итерация добавляет один и забирает один. Строки длиннее буфера
+// малых строк и перемещаются в очередь и обратно; второй аргумент —
+// режим хранения (0 — Linked, 1 — Ring)
+static void BM_QueueSteadyState(benchmark::State& state) {
+    const int depth = state.range(0);
+    Queue queue(state.range(1) == 0 ? Queue::StorageMode::Linked : Queue::StorageMode::Ring);
+    
+    for (int i = 0; i < depth; ++i) {
+        queue.enqueue("job_payload_with_a_long_description_" + std::to_string(i));
+    }
+    std::string job = "job_payload_with_a_long_description_next";
+    
+    size_t before = allocationCount.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        queue.enqueue(std::move(job));
+        job = queue.dequeue();
+        benchmark::DoNotOptimize(job.data());
+    }
+    size_t allocations = allocationCount.load(std::memory_order_relaxed) - before;
+    
+    state.SetItemsProcessed(state.iterations());
+    state.counters["allocs_per_op"] = static_cast<double>(allocations) / state.iterations();
+}
+BENCHMARK(BM_QueueSteadyState)->ArgsProduct({{8, 1<<10, 64<<10}, {0, 1}});
+
 // ==================== Hash Table Benchmarks ====================
 
 static void BM_HashTableInsert(benchmark::State& state) {
@@ -264,7 +387,7 @@ static void BM_HashTableInsert(benchmark::State& state) {
     
     state.SetComplexityN(num_elements);
 }
-BENCHMARK(BM_HashTableInsert)->Range(8, 8<<10)->Complexity();
+BENCHMARK(BM_HashTableInsert)->Range(8, 8<<14)->Complexity();
 
 static void BM_HashTableSearch(benchmark::State& state) {
     const int size = state.range(0);
@@ -286,7 +409,458 @@ static void BM_HashTableSearch(benchmark::State& state) {
     
     state.SetComplexityN(size);
 }
-BENCHMARK(BM_HashTableSearch)->Range(8, 8<<10)->Complexity();
+BENCHMARK(BM_HashTableSearch)->Range(8, 8<<14)->Complexity();
+
+// Худшая задержка одной вставки: 0 — полное перехеширование, 1 — инкрементальное
+static void BM_HashTableInsertLatency(benchmark::State& state) {
+    const int num_elements = state.range(0);
+    const HashTable::ResizeMode mode = state.range(1) == 0
+        ? HashTable::ResizeMode::Immediate
+        : HashTable::ResizeMode::Incremental;
+    double maxLatencyNs = 0;
+    
+    for (auto _ : state) {
+        state.PauseTiming();
+        HashTable ht(8, 0.75, mode);
+        state.ResumeTiming();
+        
+        for (int i = 0; i < num_elements; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            ht.insert(i, "value_" + std::to_string(i));
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            maxLatencyNs = std::max(maxLatencyNs,
+                static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+        
+        benchmark::DoNotOptimize(ht);
+    }
+    
+    state.counters["max_insert_ns"] = maxLatencyNs;
+    state.SetComplexityN(num_elements);
+}
+BENCHMARK(BM_HashTableInsertLatency)
+    ->ArgsProduct({{8<<10, 8<<14}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+// Сравнение движков пробирования: 0 — двойное хеширование, 1 — группы по 16
+static HashTable::ProbeMode probeModeArg(int64_t arg) {
+    return arg == 0 ? HashTable::ProbeMode::DoubleHashing : HashTable::ProbeMode::Grouped;
+}
+
+// Случайные неотрицательные ключи: последовательные ключи слишком
+// благоприятны для hashFunction, которая берёт остаток от деления
+static std::vector<int> randomKeys(int count, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dis(0, 1 << 30);
+    std::vector<int> keys(count);
+    for (int& key : keys) {
+        key = dis(gen);
+    }
+    return keys;
+}
+
+static void BM_HashTableProbeInsert(benchmark::State& state) {
+    const int num_elements = state.range(0);
+    const std::vector<int> keys = randomKeys(num_elements, 1);
+    const std::string value = "value";
+    
+    for (auto _ : state) {
+        state.PauseTiming();
+        HashTable ht(8, 0.75, HashTable::ResizeMode::Immediate, probeModeArg(state.range(1)));
+        state.ResumeTiming();
+        
+        for (int key : keys) {
+            ht.insert(key, value);
+        }
+        
+        benchmark::DoNotOptimize(ht);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * num_elements);
+}
+BENCHMARK(BM_HashTableProbeInsert)->ArgsProduct({{8<<10, 8<<14, 8<<17}, {0, 1}});
+
+// Поиск существующих (третий аргумент 1) или отсутствующих (0) ключей
+static void BM_HashTableProbeSearch(benchmark::State& state) {
+    const int size = state.range(0);
+    const bool hits = state.range(2) != 0;
+    HashTable ht(8, 0.75, HashTable::ResizeMode::Immediate, probeModeArg(state.range(1)));
+    
+    const std::vector<int> stored = randomKeys(size, 1);
+    for (int key : stored) {
+        ht.insert(key, "value");
+    }
+    
+    // Промахи берутся из другого потока случайных чисел
+    std::vector<int> keys = hits ? stored : randomKeys(size, 2);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(3));
+    
+    size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ht.search(keys[next]));
+        if (++next == keys.size()) {
+            next = 0;
+        }
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HashTableProbeSearch)->ArgsProduct({{8<<10, 8<<14, 8<<17}, {0, 1}, {0, 1}});
+
+// Выделения памяти на один поиск: 0 — search() с копией строки,
+// 1 — find() без копирования, 2 — contains()
+static void BM_HashTableLookupAllocations(benchmark::State& state) {
+    const int size = 8 << 10;
+    HashTable ht(size * 2);
+    
+    // Значения длиннее буфера малых строк, чтобы копия шла в кучу
+    for (int i = 0; i < size; ++i) {
+        ht.insert(i, "cached_value_with_a_long_payload_" + std::to_string(i));
+    }
+    
+    size_t key = 0;
+    size_t before = allocationCount.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        int k = static_cast<int>(key++ & (size * 2 - 1)); // Половина промахов
+        if (state.range(0) == 0) {
+            benchmark::DoNotOptimize(ht.search(k));
+        } else if (state.range(0) == 1) {
+            benchmark::DoNotOptimize(ht.find(k));
+        } else {
+            benchmark::DoNotOptimize(ht.contains(k));
+        }
+    }
+    size_t allocations = allocationCount.load(std::memory_order_relaxed) - before;
+    
+    state.counters["allocs_per_lookup"] = static_cast<double>(allocations) / state.iterations();
+}
+BENCHMARK(BM_HashTableLookupAllocations)->Arg(0)->Arg(1)->Arg(2);
+
+// Ключи заданного распределения: 0 — последовательные, 1 — с шагом 1024
+// (идентификаторы из разных диапазонов), 2 — случайные
+static std::vector<int> distributedKeys(int count, int64_t distribution) {
+    if (distribution == 2) {
+        return randomKeys(count, 1);
+    }
+    std::vector<int> keys(count);
+    for (int i = 0; i < count; ++i) {
+        keys[i] = distribution == 1 ? i * 1024 : i;
+    }
+    return keys;
+}
+
+// Длина проб и скорость поиска для разных распределений ключей.
+// Аргументы: распределение, движок пробирования. Шаблонный параметр — хешер:
+// IdentityHash воспроизводит прежнюю схему key % capacity
+template <typename Hash>
+static void BM_HashTableProbeLength(benchmark::State& state) {
+    const int size = 1 << 16;
+    BasicHashTable<int, std::string, Hash> ht(8, 0.75, HashTable::ResizeMode::Immediate,
+                                              probeModeArg(state.range(1)));
+    
+    std::vector<int> keys = distributedKeys(size, state.range(0));
+    for (int key : keys) {
+        ht.insert(key, "value");
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(3));
+    
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ht.find(keys[i]));
+        if (++i == keys.size()) {
+            i = 0;
+        }
+    }
+    
+    state.counters["avg_probes"] = ht.getAverageProbeLength();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_HashTableProbeLength, IdentityHash)->ArgsProduct({{0, 1, 2}, {0, 1}});
+BENCHMARK_TEMPLATE(BM_HashTableProbeLength, DefaultHash<int>)->ArgsProduct({{0, 1, 2}, {0, 1}});
+
+// Строковые ключи с хешером по умолчанию
+static void BM_HashTableStringKeys(benchmark::State& state) {
+    const int size = state.range(0);
+    BasicHashTable<std::string, std::string> ht(8, 0.75, HashTable::ResizeMode::Immediate,
+                                                probeModeArg(state.range(1)));
+    
+    std::vector<std::string> keys;
+    for (int i = 0; i < size; ++i) {
+        keys.push_back("session:" + std::to_string(i * 7919));
+        ht.insert(keys.back(), "value");
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(3));
+    
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ht.find(keys[i]));
+        if (++i == keys.size()) {
+            i = 0;
+        }
+    }
+    
+    state.counters["avg_probes"] = ht.getAverageProbeLength();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HashTableStringKeys)->ArgsProduct({{1 << 10, 1 << 16}, {0, 1}});
+
+// Пакетный поиск против поштучного на таблицах больше кеша L2/L3.
+// Аргументы: число ключей, движок пробирования, 0 — find() в цикле, 1 — searchBatch()
+static void BM_HashTableSearchBatch(benchmark::State& state) {
+    const int size = state.range(0);
+    const bool batched = state.range(2) != 0;
+    HashTable ht(8, 0.75, HashTable::ResizeMode::Immediate, probeModeArg(state.range(1)));
+    
+    const std::vector<int> stored = randomKeys(size, 1);
+    for (int key : stored) {
+        ht.insert(key, "value");
+    }
+    
+    // Запрос из нескольких сотен ключей, как в одном обращении к кешу
+    const size_t REQUEST = 256;
+    std::vector<int> keys = stored;
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(3));
+    std::vector<const std::string*> out(REQUEST);
+    
+    size_t offset = 0;
+    for (auto _ : state) {
+        const int* request = keys.data() + offset;
+        if (batched) {
+            ht.searchBatch(request, REQUEST, out.data());
+        } else {
+            for (size_t i = 0; i < REQUEST; ++i) {
+                out[i] = ht.find(request[i]);
+            }
+        }
+        benchmark::DoNotOptimize(out.data());
+        
+        offset += REQUEST;
+        if (offset + REQUEST > keys.size()) {
+            offset = 0;
+        }
+    }
+    
+    state.SetItemsProcessed(state.iterations() * REQUEST);
+}
+BENCHMARK(BM_HashTableSearchBatch)->ArgsProduct({{1 << 16, 1 << 20, 1 << 22}, {0, 1}, {0, 1}});
+
+// Время "холодного старта": загрузка таблицы из файла и первые 1000 поисков.
+// Аргументы: число элементов, 0 — deserializeFromFile, 1 — снимок через mmap
+static void BM_HashTableSnapshotLoad(benchmark::State& state) {
+    const int size = state.range(0);
+    const bool mapped = state.range(1) != 0;
+    const std::string filename = mapped ? "bench_snapshot.bin" : "bench_serialized.bin";
+    
+    const std::vector<int> keys = randomKeys(size, 1);
+    {
+        HashTable source;
+        for (int key : keys) {
+            source.insert(key, "Value_" + std::to_string(key));
+        }
+        if (mapped) {
+            MappedHashTable::writeSnapshot(source, filename);
+        } else {
+            source.serializeToFile(filename);
+        }
+    }
+    
+    for (auto _ : state) {
+        if (mapped) {
+            MappedHashTable ht(filename);
+            for (int i = 0; i < 1000; ++i) {
+                benchmark::DoNotOptimize(ht.contains(keys[i % size]));
+            }
+        } else {
+            HashTable ht;
+            ht.deserializeFromFile(filename);
+            for (int i = 0; i < 1000; ++i) {
+                benchmark::DoNotOptimize(ht.find(keys[i % size]));
+            }
+        }
+    }
+    
+    std::remove(filename.c_str());
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_HashTableSnapshotLoad)
+    ->ArgsProduct({{1 << 16, 1 << 20}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+// ==================== Concurrent Hash Table Benchmarks ====================
+
+// Общая рабочая нагрузка: 90% чтений и 10% записей по случайным ключам
+const int CONCURRENT_KEYS = 1 << 16;
+
+// Базовый вариант: одна HashTable под одним мьютексом
+static void BM_HashTableGlobalMutex(benchmark::State& state) {
+    static std::mutex mutex;
+    static HashTable ht(CONCURRENT_KEYS * 2);
+    if (state.thread_index() == 0) {
+        for (int i = 0; i < CONCURRENT_KEYS; ++i) {
+            ht.insert(i, "value_" + std::to_string(i));
+        }
+    }
+    
+    std::mt19937 gen(state.thread_index());
+    std::uniform_int_distribution<> dis(0, CONCURRENT_KEYS - 1);
+    const std::string value = "updated";
+    
+    for (auto _ : state) {
+        int key = dis(gen);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (key % 10 == 0) {
+            ht.insert(key, value);
+        } else {
+            benchmark::DoNotOptimize(ht.search(key));
+        }
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HashTableGlobalMutex)
+    ->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->UseRealTime();
+
+static void BM_ConcurrentHashTable(benchmark::State& state) {
+    static ConcurrentHashTable ht(64);
+    if (state.thread_index() == 0) {
+        for (int i = 0; i < CONCURRENT_KEYS; ++i) {
+            ht.insert(i, "value_" + std::to_string(i));
+        }
+    }
+    
+    std::mt19937 gen(state.thread_index());
+    std::uniform_int_distribution<> dis(0, CONCURRENT_KEYS - 1);
+    const std::string value = "updated";
+    
+    for (auto _ : state) {
+        int key = dis(gen);
+        if (key % 10 == 0) {
+            ht.insert(key, value);
+        } else {
+            benchmark::DoNotOptimize(ht.search(key));
+        }
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConcurrentHashTable)
+    ->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->UseRealTime();
+
+// ==================== Concurrent Queue Benchmarks ====================
+
+// Прежний способ передачи работы между потоками: Queue под мьютексом
+// с условной переменной. Интерфейс совпадает с BlockingQueue
+class MutexHandoffQueue {
+private:
+    Queue queue;
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    bool closed;
+
+public:
+    explicit MutexHandoffQueue(size_t) : closed(false) {}
+    
+    bool enqueue(std::string&& value) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.enqueue(std::move(value));
+        }
+        notEmpty.notify_one();
+        return true;
+    }
+    
+    bool dequeue(std::string& out) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this]() { return !queue.isEmpty() || closed; });
+        if (queue.isEmpty()) {
+            return false;
+        }
+        out = queue.dequeue();
+        return true;
+    }
+    
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+    }
+};
+
+// Пропускная способность: range(0) производителей передают по
+// HANDOFF_ITEMS значений range(1) потребителям через очередь на 1024 места
+static const int HANDOFF_ITEMS = 20000;
+
+template<typename Handoff>
+static void BM_QueueHandoffThroughput(benchmark::State& state) {
+    const int producers = state.range(0);
+    const int consumers = state.range(1);
+    
+    for (auto _ : state) {
+        Handoff queue(1024);
+        std::vector<std::thread> producerThreads;
+        std::vector<std::thread> consumerThreads;
+        
+        for (int c = 0; c < consumers; ++c) {
+            consumerThreads.emplace_back([&queue]() {
+                std::string job;
+                while (queue.dequeue(job)) {
+                    benchmark::DoNotOptimize(job.data());
+                }
+            });
+        }
+        for (int p = 0; p < producers; ++p) {
+            producerThreads.emplace_back([&queue]() {
+                for (int i = 0; i < HANDOFF_ITEMS; ++i) {
+                    queue.enqueue(std::string("job"));
+                }
+            });
+        }
+        
+        for (auto& thread : producerThreads) {
+            thread.join();
+        }
+        queue.close();
+        for (auto& thread : consumerThreads) {
+            thread.join();
+        }
+    }
+    
+    state.SetItemsProcessed(state.iterations() * producers * HANDOFF_ITEMS);
+}
+BENCHMARK_TEMPLATE(BM_QueueHandoffThroughput, MutexHandoffQueue)
+    ->ArgsProduct({{1, 2, 4}, {1, 2, 4}})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueueHandoffThroughput, BlockingQueue<MpmcQueue>)
+    ->ArgsProduct({{1, 2, 4}, {1, 2, 4}})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueueHandoffThroughput, BlockingQueue<SpscQueue>)
+    ->Args({1, 1})->UseRealTime();
+
+// Задержка: сообщение уходит в поток-отражатель и возвращается обратно,
+// время итерации — полный круг через две очереди
+template<typename Handoff>
+static void BM_QueueHandoffLatency(benchmark::State& state) {
+    Handoff request(64);
+    Handoff response(64);
+    std::thread echo([&request, &response]() {
+        std::string message;
+        while (request.dequeue(message)) {
+            response.enqueue(std::move(message));
+        }
+    });
+    
+    std::string message = "ping";
+    for (auto _ : state) {
+        request.enqueue(std::move(message));
+        response.dequeue(message);
+    }
+    
+    request.close();
+    echo.join();
+}
+BENCHMARK_TEMPLATE(BM_QueueHandoffLatency, MutexHandoffQueue)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueueHandoffLatency, BlockingQueue<MpmcQueue>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueueHandoffLatency, BlockingQueue<SpscQueue>)->UseRealTime();
 
 // ==================== Tree Benchmarks ====================
 
@@ -307,7 +881,7 @@ static void BM_TreeInsert(benchmark::State& state) {
     
     state.SetComplexityN(num_elements);
 }
-BENCHMARK(BM_TreeInsert)->Range(8, 8<<10)->Complexity();
+BENCHMARK(BM_TreeInsert)->Range(8, 8<<17)->Complexity();
 
 static void BM_TreeSearch(benchmark::State& state) {
     const int size = state.range(0);
@@ -349,6 +923,476 @@ static void BM_TreeTraversal(benchmark::State& state) {
 }
 BENCHMARK(BM_TreeTraversal)->Range(8, 8<<10)->Complexity();
 
+// Обходы, уничтожение и сериализация сбалансированного дерева.
+// Второй аргумент: 0 — прямой, 1 — симметричный, 2 — обратный обход
+static void BM_TreeTraversalOrder(benchmark::State& state) {
+    const int size = state.range(0);
+    Tree tree;
+    
+    for (int i = 0; i < size; ++i) {
+        tree.insert("element_" + std::to_string(i));
+    }
+    
+    for (auto _ : state) {
+        std::vector<std::string> result;
+        switch (state.range(1)) {
+            case 0: result = tree.preorder(); break;
+            case 1: result = tree.inorder(); break;
+            default: result = tree.postorder(); break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_TreeTraversalOrder)->ArgsProduct({{8<<10, 8<<14, 8<<17}, {0, 1, 2}});
+
+// Те же обходы ленивым итератором: значения не копируются в вектор
+static void BM_TreeIteratorTraversal(benchmark::State& state) {
+    const int size = state.range(0);
+    const Tree::TraversalOrder order = static_cast<Tree::TraversalOrder>(state.range(1));
+    Tree tree;
+    
+    for (int i = 0; i < size; ++i) {
+        tree.insert("element_" + std::to_string(i));
+    }
+    
+    for (auto _ : state) {
+        size_t totalLength = 0;
+        for (const std::string& value : tree.traverse(order)) {
+            totalLength += value.size();
+        }
+        benchmark::DoNotOptimize(totalLength);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_TreeIteratorTraversal)->ArgsProduct({{8<<10, 8<<14, 8<<17}, {0, 1, 2, 3}});
+
+static void BM_TreeClear(benchmark::State& state) {
+    const int size = state.range(0);
+    
+    for (auto _ : state) {
+        state.PauseTiming();
+        Tree tree;
+        for (int i = 0; i < size; ++i) {
+            tree.insert("element_" + std::to_string(i));
+        }
+        state.ResumeTiming();
+        
+        tree.clear();
+        benchmark::DoNotOptimize(tree);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_TreeClear)->Arg(8<<10)->Arg(8<<14)->Arg(8<<17);
+
+// Опрос размера и свойств формы, как при мониторинге
+static void BM_TreeShapeQueries(benchmark::State& state) {
+    const int size = state.range(0);
+    Tree tree;
+    
+    for (int i = 0; i < size; ++i) {
+        tree.insert("element_" + std::to_string(i));
+    }
+    
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.size());
+        benchmark::DoNotOptimize(tree.height());
+        benchmark::DoNotOptimize(tree.isFullBinaryTree());
+        benchmark::DoNotOptimize(tree.isCompleteBinaryTree());
+        benchmark::DoNotOptimize(tree.isPerfectBinaryTree());
+    }
+    
+    state.SetComplexityN(size);
+}
+BENCHMARK(BM_TreeShapeQueries)->Range(8<<7, 8<<17)->Complexity();
+
+static void BM_TreeSerializeRoundTrip(benchmark::State& state) {
+    const int size = state.range(0);
+    const std::string filename = "bench_tree_roundtrip.bin";
+    Tree tree;
+    
+    for (int i = 0; i < size; ++i) {
+        tree.insert("element_" + std::to_string(i));
+    }
+    
+    for (auto _ : state) {
+        tree.serializeToFile(filename);
+        Tree restored;
+        restored.deserializeFromFile(filename);
+        benchmark::DoNotOptimize(restored);
+    }
+    
+    std::remove(filename.c_str());
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_TreeSerializeRoundTrip)->Arg(8<<10)->Arg(8<<14)->Arg(8<<17)->Unit(benchmark::kMillisecond);
+
+// Число потоков от 1 до числа ядер (удваивая), второй аргумент бенчмарка
+static void treeThreadArgs(benchmark::internal::Benchmark* b) {
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; ; threads *= 2) {
+        unsigned current = std::min(threads, cores);
+        b->Args({8<<17, static_cast<int>(current)});
+        if (current == cores) break;
+    }
+}
+
+static void BM_TreeParallelBuild(benchmark::State& state) {
+    const int size = state.range(0);
+    const unsigned threads = state.range(1);
+    std::vector<std::string> values;
+    values.reserve(size);
+    for (int i = 0; i < size; ++i) {
+        values.push_back("element_" + std::to_string(i));
+    }
+    
+    Tree tree;
+    for (auto _ : state) {
+        tree.buildFrom(values, threads);
+        benchmark::DoNotOptimize(tree.getRoot());
+        state.PauseTiming();
+        tree.clear();
+        state.ResumeTiming();
+    }
+    
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_TreeParallelBuild)->Apply(treeThreadArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_TreeParallelCount(benchmark::State& state) {
+    const int size = state.range(0);
+    const unsigned threads = state.range(1);
+    std::vector<std::string> values;
+    values.reserve(size);
+    for (int i = 0; i < size; ++i) {
+        values.push_back("element_" + std::to_string(i));
+    }
+    Tree tree;
+    tree.buildFrom(values);
+    
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.parallelCount([](const std::string& value) {
+            return value.back() == '7';
+        }, threads));
+    }
+    
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_TreeParallelCount)->Apply(treeThreadArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Загрузка готового файла: время чтения и размер файла
+static void BM_TreeDeserialize(benchmark::State& state) {
+    const int size = state.range(0);
+    const std::string filename = "bench_tree_load.bin";
+    {
+        Tree tree;
+        for (int i = 0; i < size; ++i) {
+            tree.insert("element_" + std::to_string(i));
+        }
+        tree.serializeToFile(filename);
+    }
+    
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    const double fileBytes = static_cast<double>(file.tellg());
+    file.close();
+    
+    for (auto _ : state) {
+        Tree restored;
+        restored.deserializeFromFile(filename);
+        benchmark::DoNotOptimize(restored.getRoot());
+        state.PauseTiming();
+        restored.clear();
+        state.ResumeTiming();
+    }
+    
+    std::remove(filename.c_str());
+    state.counters["file_bytes"] = fileBytes;
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_TreeDeserialize)->Arg(8<<10)->Arg(8<<17)->Unit(benchmark::kMillisecond);
+
+// Второй аргумент: 0 — узлы с указателями, 1 — неявное дерево в массиве
+static Tree::StorageMode storageModeArg(int64_t arg) {
+    return arg == 0 ? Tree::StorageMode::Linked : Tree::StorageMode::Implicit;
+}
+
+static void BM_TreeStorageInsert(benchmark::State& state) {
+    const int num_elements = state.range(0);
+    
+    for (auto _ : state) {
+        state.PauseTiming();
+        Tree tree(storageModeArg(state.range(1)));
+        state.ResumeTiming();
+        
+        for (int i = 0; i < num_elements; ++i) {
+            tree.insert("element_" + std::to_string(i));
+        }
+        
+        benchmark::DoNotOptimize(tree);
+        
+        // Уничтожение дерева не входит в замер
+        state.PauseTiming();
+        tree.clear();
+        state.ResumeTiming();
+    }
+    
+    state.SetItemsProcessed(state.iterations() * num_elements);
+}
+BENCHMARK(BM_TreeStorageInsert)->ArgsProduct({{8<<10, 8<<14, 8<<17}, {0, 1}});
+
+static void BM_TreeStorageLevelOrder(benchmark::State& state) {
+    const int size = state.range(0);
+    Tree tree(storageModeArg(state.range(1)));
+    
+    for (int i = 0; i < size; ++i) {
+        tree.insert("element_" + std::to_string(i));
+    }
+    
+    for (auto _ : state) {
+        auto result = tree.levelOrder();
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(tree.isCompleteBinaryTree());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_TreeStorageLevelOrder)->ArgsProduct({{8<<10, 8<<14, 8<<17}, {0, 1}});
+
+// Упорядоченное дерево: те же операции, что у Tree, на тех же данных
+static void BM_OrderedTreeInsert(benchmark::State& state) {
+    const int num_elements = state.range(0);
+    
+    for (auto _ : state) {
+        state.PauseTiming();
+        OrderedTree tree;
+        state.ResumeTiming();
+        
+        for (int i = 0; i < num_elements; ++i) {
+            tree.insert("element_" + std::to_string(i));
+        }
+        
+        benchmark::DoNotOptimize(tree);
+    }
+    
+    state.SetComplexityN(num_elements);
+}
+BENCHMARK(BM_OrderedTreeInsert)->Range(8, 8<<17)->Complexity();
+
+static void BM_OrderedTreeSearch(benchmark::State& state) {
+    const int size = state.range(0);
+    OrderedTree tree;
+    
+    // Заполняем дерево
+    for (int i = 0; i < size; ++i) {
+        tree.insert("element_" + std::to_string(i));
+    }
+    
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> dis(0, size - 1);
+    
+    for (auto _ : state) {
+        int target = dis(gen);
+        benchmark::DoNotOptimize(tree.search("element_" + std::to_string(target)));
+    }
+    
+    state.SetComplexityN(size);
+}
+BENCHMARK(BM_OrderedTreeSearch)->Range(8, 8<<17)->Complexity();
+
+// Диапазонный запрос на 100 соседних значений и k-й элемент
+static void BM_OrderedTreeRange(benchmark::State& state) {
+    const int size = state.range(0);
+    OrderedTree tree;
+    
+    for (int i = 0; i < size; ++i) {
+        tree.insert("element_" + std::to_string(i));
+    }
+    
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dis(0, size - 101);
+    
+    for (auto _ : state) {
+        int first = dis(gen);
+        int count = 0;
+        tree.forEachInRange(tree.kth(first), tree.kth(first + 100), [&count](const std::string&) {
+            count++;
+        });
+        benchmark::DoNotOptimize(count);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * 100);
+}
+BENCHMARK(BM_OrderedTreeRange)->Range(8<<7, 8<<17);
+
+// Адаптеры упорядоченных индексов строка -> строка для общих бенчмарков.
+// Tree не упорядочено: поиск и диапазон у него — полный обход
+struct TreeIndex {
+    Tree tree;
+    void insert(const std::string& key, const std::string&) { tree.insert(key); }
+    bool lookup(const std::string& key) const { return tree.search(key); }
+    int scan(const std::string& low, const std::string& high) const {
+        int count = 0;
+        for (const std::string& key : tree.inorder()) {
+            count += !(key < low) && key < high;
+        }
+        return count;
+    }
+};
+
+struct StdMapIndex {
+    std::map<std::string, std::string> map;
+    void insert(const std::string& key, const std::string& value) { map[key] = value; }
+    bool lookup(const std::string& key) const { return map.find(key) != map.end(); }
+    int scan(const std::string& low, const std::string& high) const {
+        int count = 0;
+        for (auto it = map.lower_bound(low); it != map.end() && it->first < high; ++it) {
+            count++;
+        }
+        return count;
+    }
+};
+
+struct BPlusTreeIndex {
+    BPlusTree tree;
+    void insert(const std::string& key, const std::string& value) { tree.insert(key, value); }
+    bool lookup(const std::string& key) const { return tree.contains(key); }
+    int scan(const std::string& low, const std::string& high) const {
+        int count = 0;
+        tree.forEachInRange(low, high, [&count](const std::string&, const std::string&) {
+            count++;
+        });
+        return count;
+    }
+};
+
+// Индекс из size ключей вида "catalog/item/<i>", вставленных в случайном порядке.
+// Возвращает ключи по возрастанию
+template <typename Index>
+static std::vector<std::string> fillIndex(Index& index, int size) {
+    std::vector<std::string> keys;
+    keys.reserve(size);
+    for (int i = 0; i < size; ++i) {
+        keys.push_back("catalog/item/" + std::to_string(i));
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(1));
+    for (const std::string& key : keys) {
+        index.insert(key, "value");
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+template <typename Index>
+static void BM_OrderedIndexLookup(benchmark::State& state) {
+    const int size = state.range(0);
+    Index index;
+    std::vector<std::string> keys = fillIndex(index, size);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(2));
+    
+    size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.lookup(keys[next]));
+        if (++next == keys.size()) {
+            next = 0;
+        }
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_OrderedIndexLookup, TreeIndex)->Range(8<<7, 8<<10);
+BENCHMARK_TEMPLATE(BM_OrderedIndexLookup, StdMapIndex)->Range(8<<7, 8<<17);
+BENCHMARK_TEMPLATE(BM_OrderedIndexLookup, BPlusTreeIndex)->Range(8<<7, 8<<17);
+
+// Просмотр 100 соседних ключей
+template <typename Index>
+static void BM_OrderedIndexScan(benchmark::State& state) {
+    const int size = state.range(0);
+    Index index;
+    const std::vector<std::string> keys = fillIndex(index, size);
+    
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<> dis(0, size - 101);
+    
+    for (auto _ : state) {
+        int first = dis(gen);
+        benchmark::DoNotOptimize(index.scan(keys[first], keys[first + 100]));
+    }
+    
+    state.SetItemsProcessed(state.iterations() * 100);
+}
+BENCHMARK_TEMPLATE(BM_OrderedIndexScan, TreeIndex)->Range(8<<7, 8<<10);
+BENCHMARK_TEMPLATE(BM_OrderedIndexScan, StdMapIndex)->Range(8<<7, 8<<17);
+BENCHMARK_TEMPLATE(BM_OrderedIndexScan, BPlusTreeIndex)->Range(8<<7, 8<<17);
+
+// ==================== Node Pool Benchmarks ====================
+
+// Адаптеры узловых контейнеров: построение из n значений и уничтожение.
+// Второй аргумент бенчмарка: 0 — узлы через new, 1 — пул узлов
+struct SinglyListNodes {
+    SinglyList list;
+    explicit SinglyListNodes(NodeAllocation allocation) : list(allocation) {}
+    void add(const std::string& value) { list.insertBack(value); }
+};
+
+struct DoublyListNodes {
+    DoublyList list;
+    explicit DoublyListNodes(NodeAllocation allocation) : list(allocation) {}
+    void add(const std::string& value) { list.insertBack(value); }
+};
+
+struct StackNodes {
+    Stack stack;
+    explicit StackNodes(NodeAllocation allocation) : stack(allocation) {}
+    void add(const std::string& value) { stack.push(value); }
+};
+
+struct QueueNodes {
+    Queue queue;
+    explicit QueueNodes(NodeAllocation allocation) : queue(allocation) {}
+    void add(const std::string& value) { queue.enqueue(value); }
+};
+
+struct TreeNodes {
+    Tree tree;
+    explicit TreeNodes(NodeAllocation allocation) : tree(Tree::StorageMode::Linked, allocation) {}
+    void add(const std::string& value) { tree.insert(value); }
+};
+
+template<typename Container>
+static void BM_NodeAllocationBuildDestroy(benchmark::State& state) {
+    const int size = state.range(0);
+    const NodeAllocation allocation = state.range(1) ? NodeAllocation::Pooled : NodeAllocation::Heap;
+    std::vector<std::string> values;
+    values.reserve(size);
+    for (int i = 0; i < size; ++i) {
+        values.push_back("element_" + std::to_string(i));
+    }
+    
+    for (auto _ : state) {
+        Container container(allocation);
+        for (const auto& value : values) {
+            container.add(value);
+        }
+        benchmark::DoNotOptimize(container);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK_TEMPLATE(BM_NodeAllocationBuildDestroy, SinglyListNodes)
+    ->ArgsProduct({{8<<10, 8<<14, 8<<17}, {0, 1}});
+BENCHMARK_TEMPLATE(BM_NodeAllocationBuildDestroy, DoublyListNodes)
+    ->ArgsProduct({{8<<10, 8<<14, 8<<17}, {0, 1}});
+BENCHMARK_TEMPLATE(BM_NodeAllocationBuildDestroy, StackNodes)
+    ->ArgsProduct({{8<<10, 8<<14, 8<<17}, {0, 1}});
+BENCHMARK_TEMPLATE(BM_NodeAllocationBuildDestroy, QueueNodes)
+    ->ArgsProduct({{8<<10, 8<<14, 8<<17}, {0, 1}});
+BENCHMARK_TEMPLATE(BM_NodeAllocationBuildDestroy, TreeNodes)
+    ->ArgsProduct({{8<<10, 8<<14, 8<<17}, {0, 1}});
+
 // ==================== Comparison Benchmarks ====================
 
 static void BM_CompareInsertion(benchmark::State& state) {
@@ -1,6 +1,13 @@
 #include <gtest/gtest.h>
 #include "../src/hash_table.h"
+#include "../src/concurrent_hash_table.h"
+#include "../src/mapped_hash_table.h"
 #include <string>
+#include <climits>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <algorithm>
 
 TEST(HashTableTest, DefaultConstructor) {
     HashTable ht;
@@ -14,7 +21,7 @@ TEST(HashTableTest, ParameterizedConstructor) {
     EXPECT_EQ(ht.getCapacity(), 16);
     EXPECT_EQ(ht.getSize(), 0);
 }
- 
+
 TEST(HashTableTest, Insert) {
     HashTable ht;
     ht.insert(1, "Alice");
@@ -208,6 +215,625 @@ TEST(HashTableTest, LargeTable) {
     EXPECT_EQ(ht.getSize(), N/2);
 }
 
+TEST(HashTableTest, RemoveKeepsProbeChain) {
+    // Тождественный хешер: все три ключа попадают в одну начальную ячейку при capacity=8
+    BasicHashTable<int, std::string, IdentityHash> ht(8, 0.75);
+    
+    ht.insert(1, "A");
+    ht.insert(9, "B");
+    ht.insert(17, "C");
+    
+    ht.remove(1);
+    EXPECT_EQ(ht.getTombstones(), 1);
+    
+    // Удаление не должно разрывать цепочку проб
+    EXPECT_EQ(ht.search(9), "B");
+    EXPECT_EQ(ht.search(17), "C");
+    
+    // Повторная вставка существующего ключа не создаёт дубликат
+    ht.insert(17, "C2");
+    EXPECT_EQ(ht.getSize(), 2);
+    EXPECT_EQ(ht.search(17), "C2");
+    
+    // Новый ключ занимает надгробие
+    ht.insert(25, "D");
+    EXPECT_EQ(ht.getSize(), 3);
+    EXPECT_EQ(ht.getTombstones(), 0);
+    EXPECT_EQ(ht.search(25), "D");
+}
+
+TEST(HashTableTest, DeleteHeavyWorkloadCompactsInPlace) {
+    HashTable ht(64, 0.75);
+    const int WINDOW = 20;
+    
+    // Скользящее окно живых ключей, как при истечении сессий
+    for (int i = 0; i < 10000; i++) {
+        ht.insert(i, "Session_" + std::to_string(i));
+        if (i >= WINDOW) {
+            ht.remove(i - WINDOW);
+        }
+    }
+    
+    // Таблица уплотняется, а не растёт
+    EXPECT_EQ(ht.getCapacity(), 64);
+    EXPECT_EQ(ht.getSize(), WINDOW);
+    EXPECT_LE(ht.getTombstones(), 16);
+    
+    for (int i = 10000 - WINDOW; i < 10000; i++) {
+        EXPECT_EQ(ht.search(i), "Session_" + std::to_string(i));
+    }
+    EXPECT_EQ(ht.search(10000 - WINDOW - 1), "Not Found");
+}
+
+TEST(HashTableTest, IncrementalResize) {
+    HashTable ht(8, 0.75, HashTable::ResizeMode::Incremental);
+    const int N = 1000;
+    bool sawMigration = false;
+    int hookCalls = 0;
+    
+    ht.setMigrationHook([&hookCalls](const HashTable::MigrationStats& stats) {
+        hookCalls++;
+        EXPECT_LE(stats.bucketsMigrated, stats.oldCapacity);
+    });
+    
+    for (int i = 0; i < N; i++) {
+        ht.insert(i, "Value_" + std::to_string(i));
+        
+        HashTable::MigrationStats stats = ht.getMigrationStats();
+        if (stats.inProgress) {
+            sawMigration = true;
+            EXPECT_EQ(stats.newCapacity, stats.oldCapacity * 2);
+        }
+        
+        // Во время переноса доступны ключи из обеих таблиц
+        EXPECT_EQ(ht.search(i / 2), "Value_" + std::to_string(i / 2));
+    }
+    
+    EXPECT_TRUE(sawMigration);
+    EXPECT_GT(hookCalls, 0);
+    EXPECT_EQ(ht.getSize(), N);
+    
+    for (int i = 0; i < N; i++) {
+        EXPECT_EQ(ht.search(i), "Value_" + std::to_string(i));
+    }
+}
+
+TEST(HashTableTest, IncrementalResizeKeepsProbesShort) {
+    // Пока новая таблица готовится, вставки идут в старую: её заполнение
+    // превышает порог не больше чем на 1/32, а средняя длина проб
+    // остаётся небольшой на всём протяжении роста
+    const int initialCapacity = 1 << 12;
+    HashTable ht(initialCapacity, 0.75, HashTable::ResizeMode::Incremental);
+    double maxOldLoad = 0;
+    double maxProbeLength = 0;
+    bool grew = false;
+    
+    for (int i = 0; !grew || ht.getMigrationStats().inProgress; i++) {
+        ht.insert(i, "Value_" + std::to_string(i));
+        HashTable::Stats stats = ht.getStats();
+        if (stats.capacity == initialCapacity) {
+            maxOldLoad = std::max(maxOldLoad,
+                                  static_cast<double>(stats.size + stats.tombstones) / stats.capacity);
+        } else {
+            grew = true;
+        }
+        if (stats.migrationInProgress && i % 64 == 0) {
+            maxProbeLength = std::max(maxProbeLength, ht.getAverageProbeLength());
+        }
+    }
+    
+    EXPECT_LE(maxOldLoad, 0.75 + 1.0 / 32 + 1.0 / initialCapacity);
+    EXPECT_GT(maxProbeLength, 0);
+    EXPECT_LT(maxProbeLength, 4.0);
+}
+
+TEST(HashTableTest, IncrementalResizeUpdateAndRemove) {
+    HashTable ht(8, 0.75, HashTable::ResizeMode::Incremental);
+    
+    for (int i = 0; i < 6; i++) {
+        ht.insert(i, "A");
+    }
+    ht.insert(6, "A"); // Запускает перенос
+    ASSERT_TRUE(ht.getMigrationStats().inProgress);
+    
+    // Ключи из старой таблицы обновляются и удаляются без дубликатов
+    for (int i = 0; i < 7; i++) {
+        ht.insert(i, "B");
+    }
+    EXPECT_EQ(ht.getSize(), 7);
+    EXPECT_EQ(ht.search(0), "B");
+    
+    ht.remove(3);
+    EXPECT_EQ(ht.getSize(), 6);
+    EXPECT_EQ(ht.search(3), "Not Found");
+    
+    // Сериализация во время переноса сохраняет все элементы
+    ht.serializeToFile("test_incremental_hash.bin");
+    HashTable ht2;
+    ht2.deserializeFromFile("test_incremental_hash.bin");
+    EXPECT_EQ(ht2.getSize(), 6);
+    EXPECT_EQ(ht2.search(6), "B");
+    EXPECT_EQ(ht2.search(3), "Not Found");
+    
+    remove("test_incremental_hash.bin");
+}
+
+TEST(HashTableTest, GroupedProbing) {
+    HashTable ht(10, 0.75, HashTable::ResizeMode::Immediate, HashTable::ProbeMode::Grouped);
+    
+    // Ёмкость округляется до степени двойки не меньше группы
+    EXPECT_EQ(ht.getCapacity(), 16);
+    EXPECT_EQ(ht.getProbeMode(), HashTable::ProbeMode::Grouped);
+    
+    const int N = 1000;
+    for (int i = 0; i < N; i++) {
+        ht.insert(i * 16, "Value_" + std::to_string(i));
+    }
+    
+    EXPECT_EQ(ht.getSize(), N);
+    EXPECT_EQ(ht.getCapacity() & (ht.getCapacity() - 1), 0);
+    
+    for (int i = 0; i < N; i++) {
+        EXPECT_EQ(ht.search(i * 16), "Value_" + std::to_string(i));
+    }
+    EXPECT_EQ(ht.search(7), "Not Found");
+    
+    for (int i = 0; i < N; i += 2) {
+        ht.remove(i * 16);
+    }
+    EXPECT_EQ(ht.getSize(), N / 2);
+    
+    for (int i = 0; i < N; i++) {
+        EXPECT_EQ(ht.search(i * 16), i % 2 == 0 ? "Not Found" : "Value_" + std::to_string(i));
+    }
+    
+    // Повторная вставка после удаления не создаёт дубликатов
+    ht.insert(16, "Updated");
+    EXPECT_EQ(ht.getSize(), N / 2);
+    EXPECT_EQ(ht.search(16), "Updated");
+}
+
+TEST(HashTableTest, GroupedProbingSerialization) {
+    HashTable ht(8, 0.75, HashTable::ResizeMode::Incremental, HashTable::ProbeMode::Grouped);
+    for (int i = -50; i < 50; i++) {
+        ht.insert(i, "V" + std::to_string(i));
+    }
+    
+    ht.serializeToFile("test_grouped_hash.bin");
+    
+    // Файл читается таблицей с любым движком пробирования
+    HashTable ht2;
+    ht2.deserializeFromFile("test_grouped_hash.bin");
+    EXPECT_EQ(ht2.getSize(), 100);
+    for (int i = -50; i < 50; i++) {
+        EXPECT_EQ(ht2.search(i), "V" + std::to_string(i));
+    }
+    
+    remove("test_grouped_hash.bin");
+}
+
+TEST(HashTableTest, FindAndContains) {
+    HashTable ht;
+    ht.insert(1, "Alice");
+    ht.insert(2, "Not Found"); // Значение, совпадающее со старым признаком промаха
+    
+    const std::string* value = ht.find(1);
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, "Alice");
+    
+    // Промах отличим от хранимого значения "Not Found"
+    ASSERT_NE(ht.find(2), nullptr);
+    EXPECT_EQ(*ht.find(2), "Not Found");
+    EXPECT_EQ(ht.find(3), nullptr);
+    
+    EXPECT_TRUE(ht.contains(1));
+    EXPECT_TRUE(ht.contains(2));
+    EXPECT_FALSE(ht.contains(3));
+    
+    ht.remove(1);
+    EXPECT_EQ(ht.find(1), nullptr);
+    EXPECT_FALSE(ht.contains(1));
+}
+
+TEST(HashTableTest, FindDuringIncrementalResize) {
+    HashTable ht(8, 0.75, HashTable::ResizeMode::Incremental, HashTable::ProbeMode::Grouped);
+    for (int i = 0; i < 200; i++) {
+        ht.insert(i, "V" + std::to_string(i));
+        for (int j = 0; j <= i; j += 17) {
+            const std::string* value = ht.find(j);
+            ASSERT_NE(value, nullptr);
+            EXPECT_EQ(*value, "V" + std::to_string(j));
+        }
+    }
+}
+
+TEST(HashTableTest, SearchBatch) {
+    const HashTable::ProbeMode modes[] = {HashTable::ProbeMode::DoubleHashing,
+                                          HashTable::ProbeMode::Grouped};
+    for (HashTable::ProbeMode mode : modes) {
+        HashTable ht(8, 0.75, HashTable::ResizeMode::Incremental, mode);
+        for (int i = 0; i < 500; i++) {
+            ht.insert(i * 3, "V" + std::to_string(i * 3));
+        }
+        
+        // Пакет длиннее внутренней ширины, с попаданиями и промахами
+        std::vector<int> keys;
+        for (int k = 0; k < 100; k++) {
+            keys.push_back(k);
+        }
+        std::vector<const std::string*> out(keys.size());
+        ht.searchBatch(keys.data(), keys.size(), out.data());
+        
+        for (size_t i = 0; i < keys.size(); i++) {
+            EXPECT_EQ(out[i], ht.find(keys[i]));
+            if (keys[i] % 3 == 0) {
+                ASSERT_NE(out[i], nullptr);
+                EXPECT_EQ(*out[i], "V" + std::to_string(keys[i]));
+            } else {
+                EXPECT_EQ(out[i], nullptr);
+            }
+        }
+        
+        // Пустой пакет допустим
+        EXPECT_NO_THROW(ht.searchBatch(keys.data(), 0, out.data()));
+    }
+}
+
+TEST(HashTableTest, NonPowerOfTwoCapacity) {
+    // Ёмкость 12 округляется до 16: при ней шаг двойного хеширования
+    // обходит все ячейки, и таблица заполняется до порога без перехеширования
+    HashTable ht(12, 0.9);
+    EXPECT_EQ(ht.getCapacity(), 16);
+    
+    for (int i = 0; i < 14; i++) {
+        ht.insert(i * 1000003, "Value_" + std::to_string(i));
+    }
+    EXPECT_EQ(ht.getCapacity(), 16);
+    EXPECT_EQ(ht.getSize(), 14);
+    for (int i = 0; i < 14; i++) {
+        EXPECT_EQ(ht.search(i * 1000003), "Value_" + std::to_string(i));
+    }
+    
+    // Файл с ёмкостью не степенью двойки загружается в округлённую таблицу
+    std::ofstream output("test_odd_capacity_hash.bin", std::ios::binary);
+    int fileCapacity = 12;
+    int fileSize = 1;
+    double threshold = 0.75;
+    output.write(reinterpret_cast<const char*>(&fileCapacity), sizeof(fileCapacity));
+    output.write(reinterpret_cast<const char*>(&fileSize), sizeof(fileSize));
+    output.write(reinterpret_cast<const char*>(&threshold), sizeof(threshold));
+    for (int i = 0; i < fileCapacity; i++) {
+        int chainLength = 0;
+        output.write(reinterpret_cast<const char*>(&chainLength), sizeof(chainLength));
+    }
+    output.close();
+    
+    HashTable loaded;
+    loaded.deserializeFromFile("test_odd_capacity_hash.bin");
+    EXPECT_EQ(loaded.getCapacity(), 16);
+    remove("test_odd_capacity_hash.bin");
+}
+
+TEST(HashTableTest, ExtremeKeysAndTinyCapacity) {
+    // INT_MIN и отрицательные ключи хешируются без переполнения
+    HashTable ht(1, 0.75);
+    ht.insert(INT_MIN, "min");
+    ht.insert(INT_MAX, "max");
+    ht.insert(-1, "minus one");
+    ht.insert(1, "one");
+    
+    EXPECT_EQ(ht.search(INT_MIN), "min");
+    EXPECT_EQ(ht.search(INT_MAX), "max");
+    EXPECT_EQ(ht.search(-1), "minus one");
+    EXPECT_EQ(ht.search(1), "one");
+    EXPECT_EQ(ht.getSize(), 4);
+    
+    ht.remove(INT_MIN);
+    EXPECT_FALSE(ht.contains(INT_MIN));
+    EXPECT_EQ(ht.search(INT_MAX), "max");
+}
+
+TEST(HashTableTest, StringKeys) {
+    const HashTable::ProbeMode modes[] = {HashTable::ProbeMode::DoubleHashing,
+                                          HashTable::ProbeMode::Grouped};
+    for (HashTable::ProbeMode mode : modes) {
+        BasicHashTable<std::string, std::string> ht(8, 0.75, HashTable::ResizeMode::Incremental, mode);
+        for (int i = 0; i < 1000; i++) {
+            // Ключи разной длины, в том числе длиннее 48 байт
+            ht.insert("user:" + std::string(i % 60, 'x') + std::to_string(i), std::to_string(i));
+        }
+        EXPECT_EQ(ht.getSize(), 1000);
+        
+        for (int i = 0; i < 1000; i += 2) {
+            ht.remove("user:" + std::string(i % 60, 'x') + std::to_string(i));
+        }
+        EXPECT_EQ(ht.getSize(), 500);
+        
+        for (int i = 0; i < 1000; i++) {
+            std::string key = "user:" + std::string(i % 60, 'x') + std::to_string(i);
+            if (i % 2 == 0) {
+                EXPECT_FALSE(ht.contains(key));
+            } else {
+                EXPECT_EQ(ht.search(key), std::to_string(i));
+            }
+        }
+        EXPECT_EQ(ht.search(""), "Not Found");
+        
+        // Сериализация строковых ключей
+        ht.serializeToFile("test_string_hash.bin");
+        BasicHashTable<std::string, std::string> restored(8, 0.75, HashTable::ResizeMode::Immediate, mode);
+        restored.deserializeFromFile("test_string_hash.bin");
+        EXPECT_EQ(restored.getSize(), 500);
+        EXPECT_EQ(restored.search("user:" + std::string(1, 'x') + "1"), "1");
+        remove("test_string_hash.bin");
+    }
+}
+
+// Хешер, сводящий все ключи в одну последовательность проб
+struct ConstantHash {
+    uint64_t operator()(int) const { return 42; }
+};
+
+TEST(HashTableTest, CustomHasherAndValueType) {
+    const HashTable::ProbeMode modes[] = {HashTable::ProbeMode::DoubleHashing,
+                                          HashTable::ProbeMode::Grouped};
+    for (HashTable::ProbeMode mode : modes) {
+        BasicHashTable<int, double, ConstantHash> ht(8, 0.75, HashTable::ResizeMode::Immediate, mode);
+        for (int i = 0; i < 100; i++) {
+            ht.insert(i, i * 0.5);
+        }
+        for (int i = 0; i < 100; i += 3) {
+            ht.remove(i);
+        }
+        
+        for (int i = 0; i < 100; i++) {
+            if (i % 3 == 0) {
+                EXPECT_EQ(ht.find(i), nullptr);
+            } else {
+                ASSERT_NE(ht.find(i), nullptr);
+                EXPECT_EQ(*ht.find(i), i * 0.5);
+            }
+        }
+        // Для нестроковых значений search возвращает значение по умолчанию
+        EXPECT_EQ(ht.search(1000), 0.0);
+    }
+    
+    // Сильный хешер разносит кратные шагу ключи, тождественный — нет
+    HashTable mixed(1 << 12, 0.75);
+    BasicHashTable<int, std::string, IdentityHash> identity(1 << 12, 0.75);
+    for (int i = 0; i < 2000; i++) {
+        mixed.insert(i * 1024, "v");
+        identity.insert(i * 1024, "v");
+    }
+    EXPECT_LT(mixed.getAverageProbeLength(), 2.0);
+    EXPECT_GT(identity.getAverageProbeLength(), mixed.getAverageProbeLength());
+}
+
+TEST(HashTableTest, Stats) {
+    HashTable ht(8, 0.75);
+    for (int i = 0; i < 100; i++) {
+        ht.insert(i, "V" + std::to_string(i));
+    }
+    ht.insert(5, "updated");
+    ht.remove(7);
+    ht.remove(1000);
+    
+    for (int i = 0; i < 100; i++) {
+        ht.contains(i);
+    }
+    ht.search(-1);
+    ht.find(-2);
+    
+    HashTable::Stats stats = ht.getStats();
+    EXPECT_EQ(stats.size, 99);
+    EXPECT_EQ(stats.capacity, ht.getCapacity());
+    EXPECT_EQ(stats.tombstones, 1);
+    EXPECT_EQ(stats.inserts, 100u);
+    EXPECT_EQ(stats.updates, 1u);
+    EXPECT_EQ(stats.removes, 1u);
+    EXPECT_EQ(stats.removeMisses, 1u);
+    EXPECT_EQ(stats.hits, 99u);
+    EXPECT_EQ(stats.misses, 3u);
+    EXPECT_GT(stats.rehashes, 0u);
+    EXPECT_GE(stats.maxRehashPauseNanos, 0u);
+    EXPECT_GE(stats.averageHitProbes(), 1.0);
+    
+    // Гистограммы согласованы со счётчиками
+    uint64_t hitTotal = 0, missTotal = 0;
+    for (int i = 0; i < HashTable::PROBE_HISTOGRAM_SIZE; i++) {
+        hitTotal += stats.hitProbes[i];
+        missTotal += stats.missProbes[i];
+    }
+    EXPECT_EQ(hitTotal, stats.hits);
+    EXPECT_EQ(missTotal, stats.misses);
+    
+    std::string json = stats.toJson();
+    EXPECT_NE(json.find("\"hits\":99"), std::string::npos);
+    EXPECT_NE(json.find("\"hitProbes\":["), std::string::npos);
+    EXPECT_NE(json.find("\"rehashes\":"), std::string::npos);
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+    
+    ht.resetStats();
+    stats = ht.getStats();
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.inserts, 0u);
+    EXPECT_EQ(stats.size, 99);
+}
+
+TEST(HashTableTest, StatsIncrementalAndCompaction) {
+    HashTable ht(64, 0.75, HashTable::ResizeMode::Incremental);
+    for (int i = 0; i < 1000; i++) {
+        ht.insert(i, "V");
+    }
+    // Удаления до порога надгробий запускают уплотнение
+    for (int i = 0; i < 1000; i++) {
+        ht.remove(i);
+    }
+    
+    HashTable::Stats stats = ht.getStats();
+    EXPECT_EQ(stats.inserts, 1000u);
+    EXPECT_EQ(stats.removes, 1000u);
+    EXPECT_GT(stats.rehashes, 0u);
+    EXPECT_GT(stats.rehashNanos, 0u);
+    EXPECT_GT(stats.compactions, 0u);
+}
+
+TEST(ConcurrentHashTableTest, BasicOperations) {
+    ConcurrentHashTable ht(4);
+    EXPECT_EQ(ht.getShardCount(), 4);
+    EXPECT_TRUE(ht.isEmpty());
+    
+    ht.insert(1, "Alice");
+    ht.insert(2, "Bob");
+    ht.insert(1, "Alice Updated");
+    
+    EXPECT_EQ(ht.getSize(), 2);
+    EXPECT_EQ(ht.search(1), "Alice Updated");
+    EXPECT_EQ(ht.search(2), "Bob");
+    EXPECT_EQ(ht.search(3), "Not Found");
+    
+    std::string buffer;
+    EXPECT_TRUE(ht.tryGet(2, buffer));
+    EXPECT_EQ(buffer, "Bob");
+    EXPECT_FALSE(ht.tryGet(3, buffer));
+    EXPECT_TRUE(ht.contains(2));
+    EXPECT_FALSE(ht.contains(3));
+    
+    ht.remove(1);
+    EXPECT_EQ(ht.getSize(), 1);
+    EXPECT_EQ(ht.search(1), "Not Found");
+    
+    // Статистика складывается по сегментам
+    HashTable::Stats stats = ht.getStats();
+    EXPECT_EQ(stats.size, 1);
+    EXPECT_EQ(stats.inserts, 2u);
+    EXPECT_EQ(stats.updates, 1u);
+    EXPECT_EQ(stats.removes, 1u);
+    EXPECT_EQ(stats.hits, 4u);
+    EXPECT_EQ(stats.misses, 4u);
+    
+    ht.clear();
+    EXPECT_TRUE(ht.isEmpty());
+}
+
+TEST(ConcurrentHashTableTest, ParallelWritersAndReaders) {
+    ConcurrentHashTable ht(8);
+    const int THREADS = 4;
+    const int PER_THREAD = 2000;
+    
+    // Каждый поток пишет свой диапазон ключей, удаляет половину
+    // и читает ключи соседнего потока
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&ht, t]() {
+            int base = t * PER_THREAD;
+            for (int i = 0; i < PER_THREAD; i++) {
+                ht.insert(base + i, "Value_" + std::to_string(base + i));
+            }
+            for (int i = 0; i < PER_THREAD; i += 2) {
+                ht.remove(base + i);
+            }
+            int neighbour = ((t + 1) % THREADS) * PER_THREAD;
+            for (int i = 0; i < PER_THREAD; i++) {
+                std::string value = ht.search(neighbour + i);
+                EXPECT_TRUE(value == "Not Found" ||
+                            value == "Value_" + std::to_string(neighbour + i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    EXPECT_EQ(ht.getSize(), THREADS * PER_THREAD / 2);
+    for (int key = 0; key < THREADS * PER_THREAD; key++) {
+        EXPECT_EQ(ht.search(key), key % 2 == 0 ? "Not Found" : "Value_" + std::to_string(key));
+    }
+}
+
+TEST(MappedHashTableTest, LookupsOnMappedImage) {
+    // Снимок снимается посреди инкрементального роста
+    HashTable source(8, 0.75, HashTable::ResizeMode::Incremental);
+    for (int i = -500; i < 500; i++) {
+        source.insert(i * 7, "Value_" + std::to_string(i * 7));
+    }
+    source.insert(INT_MIN, "");
+    MappedHashTable::writeSnapshot(source, "test_snapshot.bin");
+    
+    MappedHashTable mapped("test_snapshot.bin");
+    EXPECT_TRUE(mapped.isMapped());
+    EXPECT_EQ(mapped.getSize(), 1001);
+    
+    for (int i = -500; i < 500; i++) {
+        EXPECT_EQ(mapped.search(i * 7), "Value_" + std::to_string(i * 7));
+        EXPECT_FALSE(mapped.contains(i * 7 + 1));
+    }
+    EXPECT_TRUE(mapped.contains(INT_MIN));
+    EXPECT_EQ(mapped.search(INT_MIN), "");
+    EXPECT_EQ(mapped.search(3), "Not Found");
+    
+    // find отдаёт байты прямо из образа
+    const char* data = nullptr;
+    size_t length = 0;
+    ASSERT_TRUE(mapped.find(14, data, length));
+    EXPECT_EQ(std::string(data, length), "Value_14");
+    
+    // Чтение не материализует таблицу
+    EXPECT_TRUE(mapped.isMapped());
+    
+    remove("test_snapshot.bin");
+}
+
+TEST(MappedHashTableTest, CopyOnFirstMutation) {
+    HashTable source;
+    for (int i = 0; i < 100; i++) {
+        source.insert(i, "V" + std::to_string(i));
+    }
+    MappedHashTable::writeSnapshot(source, "test_snapshot_cow.bin");
+    
+    MappedHashTable mapped("test_snapshot_cow.bin", HashTable::ResizeMode::Immediate,
+                           HashTable::ProbeMode::Grouped);
+    mapped.insert(1000, "new");
+    EXPECT_FALSE(mapped.isMapped());
+    EXPECT_EQ(mapped.getSize(), 101);
+    
+    mapped.remove(5);
+    mapped.insert(6, "updated");
+    EXPECT_EQ(mapped.getSize(), 100);
+    EXPECT_EQ(mapped.search(5), "Not Found");
+    EXPECT_EQ(mapped.search(6), "updated");
+    EXPECT_EQ(mapped.search(99), "V99");
+    EXPECT_EQ(mapped.search(1000), "new");
+    
+    // Файл снимка не изменился
+    MappedHashTable reopened("test_snapshot_cow.bin");
+    EXPECT_EQ(reopened.getSize(), 100);
+    EXPECT_EQ(reopened.search(5), "V5");
+    EXPECT_FALSE(reopened.contains(1000));
+    
+    remove("test_snapshot_cow.bin");
+}
+
+TEST(MappedHashTableTest, InvalidSnapshot) {
+    EXPECT_THROW(MappedHashTable("no_such_snapshot.bin"), std::runtime_error);
+    
+    // Файл в обычном формате сериализации не является снимком
+    HashTable source;
+    source.insert(1, "A");
+    source.serializeToFile("test_not_snapshot.bin");
+    EXPECT_THROW(MappedHashTable("test_not_snapshot.bin"), std::runtime_error);
+    remove("test_not_snapshot.bin");
+    
+    // Пустая таблица даёт корректный пустой снимок
+    HashTable empty;
+    MappedHashTable::writeSnapshot(empty, "test_empty_snapshot.bin");
+    MappedHashTable mapped("test_empty_snapshot.bin");
+    EXPECT_TRUE(mapped.isEmpty());
+    EXPECT_FALSE(mapped.contains(0));
+    remove("test_empty_snapshot.bin");
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
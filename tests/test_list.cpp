@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include <fstream>
 #include <cstdio>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
 #include "../src/singly_list.h"
 #include "../src/doubly_list.h"
 
@@ -15,7 +19,7 @@ TEST(SinglyListTest, DefaultConstructor) {
 TEST(SinglyListTest, InsertFrontEmpty) {
     SinglyList list;
     list.insertFront("a");
-    EXPECT_EQ(list.getSize(), 1); 
+    EXPECT_EQ(list.getSize(), 1);
     EXPECT_FALSE(list.isEmpty());
 }
 
@@ -781,6 +785,297 @@ TEST(DoublyListTest, DeserializeCorruptedFile) {
     std::remove("corrupted_dbl.bin");
 }
 
+// ==================== Node Pool Tests ====================
+
+TEST(NodePoolTest, ReusesFreedBlocksAndReleasesSlabs) {
+    NodePool pool(40);
+    EXPECT_EQ(pool.getBlockSize() % alignof(std::max_align_t), 0u);
+    EXPECT_GE(pool.getBlockSize(), 40u);
+    
+    void* first = pool.allocate();
+    void* second = pool.allocate();
+    EXPECT_EQ(static_cast<char*>(second) - static_cast<char*>(first),
+              static_cast<std::ptrdiff_t>(pool.getBlockSize()));
+    
+    // Освобождённый блок выдаётся первым
+    pool.deallocate(first);
+    EXPECT_EQ(pool.allocate(), first);
+    
+    for (int i = 0; i < 1000; i++) {
+        pool.allocate();
+    }
+    EXPECT_GT(pool.getSlabCount(), 1u);
+    pool.release();
+    EXPECT_EQ(pool.getSlabCount(), 0u);
+}
+
+TEST(NodePoolTest, SlabSizeIsCappedInBytes) {
+    // Блоки развёрнутого списка (16 строк) крупнее узлов, но плита
+    // всё равно не превышает 64 КБ
+    NodePool pool(528);
+    EXPECT_LE(pool.getMaxSlabBlocks() * pool.getBlockSize(), 64u * 1024);
+    
+    const size_t blocks = 5000;
+    for (size_t i = 0; i < blocks; i++) {
+        pool.allocate();
+    }
+    EXPECT_GE(pool.getSlabCount(), blocks / pool.getMaxSlabBlocks());
+    
+    // Блок крупнее предела получает плиту на один блок
+    NodePool huge(100 * 1024);
+    EXPECT_EQ(huge.getMaxSlabBlocks(), 1u);
+    huge.allocate();
+    huge.allocate();
+    EXPECT_EQ(huge.getSlabCount(), 2u);
+}
+
+TEST(SinglyListTest, PooledAllocation) {
+    SinglyList list(NodeAllocation::Pooled);
+    EXPECT_EQ(list.getAllocation(), NodeAllocation::Pooled);
+    EXPECT_EQ(SinglyList().getAllocation(), NodeAllocation::Heap);
+    
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 500; i++) {
+            list.insertBack("value_" + std::to_string(i));
+        }
+        list.insertFront("front");
+        list.insertAfter("value_10", "after");
+        list.insertBefore("value_20", "before");
+        list.removeValue("value_30");
+        list.removeBack();
+        list.removeFront();
+        EXPECT_EQ(list.getSize(), 500);
+        EXPECT_TRUE(list.search("after"));
+        EXPECT_TRUE(list.search("before"));
+        EXPECT_FALSE(list.search("value_30"));
+        EXPECT_FALSE(list.search("value_499"));
+        
+        // После очистки пул пуст и список снова пригоден
+        list.clear();
+        EXPECT_TRUE(list.isEmpty());
+    }
+}
+
+TEST(DoublyListTest, PooledAllocation) {
+    DoublyList list(NodeAllocation::Pooled);
+    EXPECT_EQ(list.getAllocation(), NodeAllocation::Pooled);
+    
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 500; i++) {
+            list.insertBack("value_" + std::to_string(i));
+        }
+        list.insertFront("front");
+        list.insertAfter("value_10", "after");
+        list.insertBefore("value_20", "before");
+        list.removeValue("value_30");
+        list.removeBefore("value_40");
+        list.removeAfter("value_50");
+        list.removeBack();
+        EXPECT_EQ(list.getSize(), 499);
+        EXPECT_TRUE(list.search("front"));
+        EXPECT_FALSE(list.search("value_39"));
+        EXPECT_FALSE(list.search("value_51"));
+        EXPECT_FALSE(list.search("value_499"));
+        
+        list.clear();
+        EXPECT_TRUE(list.isEmpty());
+    }
+}
+
+// Содержимое списка через сериализацию (порядок и повторы значений)
+template<typename List>
+static std::string listContents(const List& list, const std::string& filename) {
+    list.serializeToFile(filename);
+    std::ifstream file(filename, std::ios::binary);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::remove(filename.c_str());
+    return buffer.str();
+}
+
+// Одна и та же случайная операция над двумя списками. Малый набор
+// значений даёт и повторы, и значения, переходящие между одним и многими
+// вхождениями
+template<typename List>
+static void applyRandomOperation(std::mt19937& gen, int values, List& checked, List& plain) {
+    auto value = [&gen, values]() { return "v" + std::to_string(gen() % values); };
+    std::string a = value();
+    std::string b = value();
+    switch (gen() % 10) {
+        case 0: checked.insertFront(a); plain.insertFront(a); break;
+        case 1: checked.insertBack(a); plain.insertBack(a); break;
+        case 2: checked.insertBefore(a, b); plain.insertBefore(a, b); break;
+        case 3: checked.insertAfter(a, b); plain.insertAfter(a, b); break;
+        case 4: checked.removeFront(); plain.removeFront(); break;
+        case 5: checked.removeBack(); plain.removeBack(); break;
+        case 6: checked.removeValue(a); plain.removeValue(a); break;
+        case 7: checked.removeBefore(a); plain.removeBefore(a); break;
+        case 8: checked.removeAfter(a); plain.removeAfter(a); break;
+        case 9: EXPECT_EQ(checked.search(a), plain.search(a)); break;
+    }
+}
+
+// Случайные операции над списком с индексом и без
+template<typename List>
+static void checkIndexedMatchesPlain(const std::string& filename) {
+    List indexed;
+    List plain;
+    indexed.setIndexed(true);
+    EXPECT_TRUE(indexed.isIndexed());
+    EXPECT_FALSE(plain.isIndexed());
+    
+    std::mt19937 gen(42);
+    for (int step = 0; step < 5000; step++) {
+        applyRandomOperation(gen, 24, indexed, plain);
+        ASSERT_EQ(indexed.getSize(), plain.getSize());
+        if (step % 250 == 0) {
+            ASSERT_EQ(listContents(indexed, filename), listContents(plain, filename));
+        }
+        if (step == 2500) {
+            // Индекс, построенный по готовому списку
+            indexed.setIndexed(false);
+            indexed.setIndexed(true);
+        }
+    }
+    EXPECT_EQ(listContents(indexed, filename), listContents(plain, filename));
+    
+    indexed.clear();
+    indexed.insertBack("x");
+    EXPECT_TRUE(indexed.search("x"));
+    EXPECT_FALSE(indexed.search("v0"));
+}
+
+TEST(SinglyListTest, IndexedMatchesPlain) {
+    checkIndexedMatchesPlain<SinglyList>("test_singly_indexed.bin");
+}
+
+TEST(DoublyListTest, IndexedMatchesPlain) {
+    checkIndexedMatchesPlain<DoublyList>("test_doubly_indexed.bin");
+}
+
+// Константный поиск не меняет индекс, поэтому его можно вызывать
+// из нескольких потоков, в том числе для повторяющихся значений
+template<typename List>
+static void checkIndexedConcurrentSearch() {
+    List list;
+    list.setIndexed(true);
+    for (int i = 0; i < 200; i++) {
+        list.insertBack("v" + std::to_string(i % 100));
+    }
+    list.removeValue("v7");
+    
+    const List& shared = list;
+    std::vector<int> found(4, 0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; t++) {
+        readers.emplace_back([&shared, &found, t]() {
+            for (int round = 0; round < 50; round++) {
+                for (int i = 0; i < 110; i++) {
+                    if (shared.search("v" + std::to_string(i))) {
+                        found[t]++;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    
+    for (int t = 0; t < 4; t++) {
+        EXPECT_EQ(found[t], 50 * 100);
+    }
+}
+
+TEST(SinglyListTest, IndexedConcurrentSearch) {
+    checkIndexedConcurrentSearch<SinglyList>();
+}
+
+TEST(DoublyListTest, IndexedConcurrentSearch) {
+    checkIndexedConcurrentSearch<DoublyList>();
+}
+
+// Случайные операции над развёрнутым и обычным списком. Набор значений
+// шире, чем в проверке индекса, чтобы список дорастал до многих блоков
+// и блоки делились и сливались
+template<typename List>
+static void checkUnrolledMatchesLinked(NodeAllocation allocation, const std::string& filename) {
+    List unrolled(List::StorageMode::Unrolled, allocation);
+    List linked;
+    EXPECT_EQ(unrolled.getStorageMode(), List::StorageMode::Unrolled);
+    EXPECT_EQ(linked.getStorageMode(), List::StorageMode::Linked);
+    EXPECT_THROW(unrolled.setIndexed(true), std::logic_error);
+    
+    std::mt19937 gen(7);
+    for (int round = 0; round < 2; round++) {
+        // Сначала рост, затем сокращение до пустого списка
+        for (int step = 0; step < 6000; step++) {
+            applyRandomOperation(gen, 200, unrolled, linked);
+            if (step < 3000 && gen() % 2 == 0) {
+                std::string value = "v" + std::to_string(gen() % 200);
+                unrolled.insertBack(value);
+                linked.insertBack(value);
+            } else if (step >= 3000 && gen() % 2 == 0) {
+                unrolled.removeFront();
+                linked.removeFront();
+            }
+            ASSERT_EQ(unrolled.getSize(), linked.getSize());
+            ASSERT_EQ(unrolled.isEmpty(), linked.isEmpty());
+            if (step % 300 == 0) {
+                ASSERT_EQ(listContents(unrolled, filename), listContents(linked, filename));
+            }
+        }
+        EXPECT_EQ(listContents(unrolled, filename), listContents(linked, filename));
+        
+        testing::internal::CaptureStdout();
+        unrolled.printForward();
+        std::string unrolledOutput = testing::internal::GetCapturedStdout();
+        testing::internal::CaptureStdout();
+        linked.printForward();
+        EXPECT_EQ(unrolledOutput, testing::internal::GetCapturedStdout());
+        
+        unrolled.clear();
+        linked.clear();
+    }
+    
+    // Чтение файла в развёрнутый список
+    for (int i = 0; i < 100; i++) {
+        linked.insertBack("value_" + std::to_string(i));
+    }
+    linked.serializeToFile(filename);
+    unrolled.deserializeFromFile(filename);
+    std::remove(filename.c_str());
+    EXPECT_EQ(unrolled.getSize(), 100);
+    EXPECT_TRUE(unrolled.search("value_99"));
+    EXPECT_EQ(listContents(unrolled, filename), listContents(linked, filename));
+}
+
+TEST(SinglyListTest, UnrolledMatchesLinked) {
+    checkUnrolledMatchesLinked<SinglyList>(NodeAllocation::Heap, "test_singly_unrolled.bin");
+    checkUnrolledMatchesLinked<SinglyList>(NodeAllocation::Pooled, "test_singly_unrolled.bin");
+}
+
+TEST(DoublyListTest, UnrolledMatchesLinked) {
+    checkUnrolledMatchesLinked<DoublyList>(NodeAllocation::Heap, "test_doubly_unrolled.bin");
+    checkUnrolledMatchesLinked<DoublyList>(NodeAllocation::Pooled, "test_doubly_unrolled.bin");
+}
+
+TEST(DoublyListTest, UnrolledPrintBackward) {
+    DoublyList unrolled(DoublyList::StorageMode::Unrolled);
+    DoublyList linked;
+    for (int i = 0; i < 40; i++) {
+        unrolled.insertBack("value_" + std::to_string(i));
+        linked.insertBack("value_" + std::to_string(i));
+    }
+    
+    testing::internal::CaptureStdout();
+    unrolled.printBackward();
+    std::string unrolledOutput = testing::internal::GetCapturedStdout();
+    testing::internal::CaptureStdout();
+    linked.printBackward();
+    EXPECT_EQ(unrolledOutput, testing::internal::GetCapturedStdout());
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
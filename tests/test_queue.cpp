@@ -1,11 +1,15 @@
 #include <gtest/gtest.h>
 #include "../src/queue.h"
+#include "../src/concurrent_queue.h"
 #include <stdexcept>
+#include <thread>
+#include <vector>
+#include <algorithm>
 
 TEST(QueueTest, DefaultConstructor) {
     Queue queue;
     EXPECT_EQ(queue.getSize(), 0);
-    EXPECT_TRUE(queue.isEmpty()); 
+    EXPECT_TRUE(queue.isEmpty());
 }
 
 TEST(QueueTest, Enqueue) {
@@ -187,6 +191,284 @@ TEST(QueueTest, ClearQueue) {
     EXPECT_EQ(queue.getSize(), 0);
 }
 
+TEST(QueueTest, PooledAllocation) {
+    Queue queue(NodeAllocation::Pooled);
+    EXPECT_EQ(queue.getAllocation(), NodeAllocation::Pooled);
+    // Кольцевому буферу пул не нужен
+    Queue ring(Queue::StorageMode::Ring, NodeAllocation::Pooled);
+    EXPECT_EQ(ring.getAllocation(), NodeAllocation::Heap);
+    
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 1000; i++) {
+            queue.enqueue("value_" + std::to_string(i));
+        }
+        for (int i = 0; i < 500; i++) {
+            EXPECT_EQ(queue.dequeue(), "value_" + std::to_string(i));
+        }
+        queue.enqueue("last");
+        EXPECT_EQ(queue.peek(), "value_500");
+        EXPECT_EQ(queue.getSize(), 501);
+        
+        queue.clear();
+        EXPECT_TRUE(queue.isEmpty());
+        EXPECT_THROW(queue.dequeue(), std::runtime_error);
+    }
+}
+
+TEST(QueueTest, RingBufferWrapsAndGrows) {
+    Queue queue(Queue::StorageMode::Ring);
+    EXPECT_EQ(queue.getStorageMode(), Queue::StorageMode::Ring);
+    EXPECT_EQ(queue.getCapacity(), 0u);
+    EXPECT_THROW(queue.dequeue(), std::runtime_error);
+    EXPECT_THROW(queue.peek(), std::runtime_error);
+    
+    // Начало буфера смещается, и рост происходит при переходе через край
+    int next = 0;
+    int expected = 0;
+    for (int round = 0; round < 50; round++) {
+        for (int i = 0; i < 7; i++) {
+            queue.enqueue("value_" + std::to_string(next++));
+        }
+        for (int i = 0; i < 5; i++) {
+            EXPECT_EQ(queue.peek(), "value_" + std::to_string(expected));
+            EXPECT_EQ(queue.dequeue(), "value_" + std::to_string(expected++));
+        }
+    }
+    EXPECT_EQ(queue.getSize(), 100);
+    EXPECT_EQ(queue.getCapacity(), 128u);
+    
+    // Установившийся режим: размер не растёт, и ёмкость тоже
+    for (int i = 0; i < 1000; i++) {
+        std::string value = "value_" + std::to_string(next++);
+        queue.enqueue(std::move(value));
+        EXPECT_EQ(queue.dequeue(), "value_" + std::to_string(expected++));
+    }
+    EXPECT_EQ(queue.getCapacity(), 128u);
+    
+    // Сериализация идёт от начала очереди, а не от начала буфера
+    queue.serializeToFile("test_ring_queue.bin");
+    Queue linked;
+    linked.deserializeFromFile("test_ring_queue.bin");
+    remove("test_ring_queue.bin");
+    EXPECT_EQ(linked.getSize(), 100);
+    while (!queue.isEmpty()) {
+        EXPECT_EQ(queue.dequeue(), linked.dequeue());
+    }
+    
+    // Очистка сохраняет ёмкость
+    queue.enqueue("a");
+    queue.enqueue("b");
+    queue.clear();
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.getCapacity(), 128u);
+    queue.enqueue("c");
+    EXPECT_EQ(queue.dequeue(), "c");
+}
+
+TEST(QueueTest, MoveEnqueueLinked) {
+    Queue queue;
+    std::string value(100, 'x');
+    queue.enqueue(std::move(value));
+    queue.enqueue(std::string(50, 'y'));
+    EXPECT_EQ(queue.dequeue(), std::string(100, 'x'));
+    EXPECT_EQ(queue.peek(), std::string(50, 'y'));
+    EXPECT_EQ(queue.getCapacity(), 0u);
+}
+
+TEST(SpscQueueTest, TryOperationsRespectCapacity) {
+    SpscQueue queue(5);
+    EXPECT_EQ(queue.getCapacity(), 8u);
+    EXPECT_TRUE(queue.isEmpty());
+    
+    std::string out;
+    EXPECT_FALSE(queue.tryDequeue(out));
+    EXPECT_FALSE(queue.tryPeek(out));
+    
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 8; i++) {
+            EXPECT_TRUE(queue.tryEnqueue("value_" + std::to_string(i)));
+        }
+        // При полной очереди значение остаётся у вызывающего
+        std::string rejected = "rejected";
+        EXPECT_FALSE(queue.tryEnqueue(std::move(rejected)));
+        EXPECT_EQ(rejected, "rejected");
+        EXPECT_EQ(queue.getSize(), 8u);
+        
+        EXPECT_TRUE(queue.tryPeek(out));
+        EXPECT_EQ(out, "value_0");
+        for (int i = 0; i < 8; i++) {
+            EXPECT_TRUE(queue.tryDequeue(out));
+            EXPECT_EQ(out, "value_" + std::to_string(i));
+        }
+        EXPECT_FALSE(queue.tryDequeue(out));
+    }
+}
+
+TEST(SpscQueueTest, TwoThreadsKeepOrder) {
+    const int count = 100000;
+    SpscQueue queue(64);
+    
+    std::thread producer([&queue]() {
+        for (int i = 0; i < count; i++) {
+            std::string value = std::to_string(i);
+            while (!queue.tryEnqueue(std::move(value))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    
+    std::string out;
+    for (int i = 0; i < count; i++) {
+        while (!queue.tryDequeue(out)) {
+            std::this_thread::yield();
+        }
+        ASSERT_EQ(out, std::to_string(i));
+    }
+    producer.join();
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(MpmcQueueTest, TryOperationsRespectCapacity) {
+    MpmcQueue queue(4);
+    EXPECT_EQ(queue.getCapacity(), 4u);
+    
+    std::string out;
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 4; i++) {
+            EXPECT_TRUE(queue.tryEnqueue("value_" + std::to_string(i)));
+        }
+        std::string rejected = "rejected";
+        EXPECT_FALSE(queue.tryEnqueue(std::move(rejected)));
+        EXPECT_EQ(rejected, "rejected");
+        EXPECT_EQ(queue.getSize(), 4u);
+        
+        for (int i = 0; i < 4; i++) {
+            EXPECT_TRUE(queue.tryDequeue(out));
+            EXPECT_EQ(out, "value_" + std::to_string(i));
+        }
+        EXPECT_FALSE(queue.tryDequeue(out));
+        EXPECT_TRUE(queue.isEmpty());
+    }
+}
+
+// Каждый производитель пишет "номер_производителя:номер"; каждое значение
+// должно быть получено ровно один раз, и один потребитель видит значения
+// одного производителя в порядке записи. finish вызывается, когда все
+// производители закончили; потребитель работает, пока dequeue не вернёт false
+template<typename Enqueue, typename Dequeue, typename Finish>
+static void checkManyThreadsDeliverEachValueOnce(int producers, int consumers, int perProducer,
+                                                 Enqueue enqueue, Dequeue dequeue, Finish finish) {
+    std::vector<std::vector<std::pair<int, int>>> received(consumers);
+    std::vector<std::thread> producerThreads;
+    std::vector<std::thread> consumerThreads;
+    
+    for (int p = 0; p < producers; p++) {
+        producerThreads.emplace_back([p, perProducer, &enqueue]() {
+            for (int i = 0; i < perProducer; i++) {
+                enqueue(std::to_string(p) + ":" + std::to_string(i));
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        consumerThreads.emplace_back([c, &received, &dequeue]() {
+            std::string out;
+            while (dequeue(out)) {
+                size_t colon = out.find(':');
+                received[c].emplace_back(std::stoi(out.substr(0, colon)),
+                                         std::stoi(out.substr(colon + 1)));
+            }
+        });
+    }
+    for (auto& thread : producerThreads) {
+        thread.join();
+    }
+    finish();
+    for (auto& thread : consumerThreads) {
+        thread.join();
+    }
+    
+    std::vector<std::pair<int, int>> all;
+    for (const auto& values : received) {
+        std::vector<int> last(producers, -1);
+        for (const auto& value : values) {
+            EXPECT_GT(value.second, last[value.first]);
+            last[value.first] = value.second;
+        }
+        all.insert(all.end(), values.begin(), values.end());
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_EQ(all.size(), static_cast<size_t>(producers * perProducer));
+    for (int p = 0; p < producers; p++) {
+        for (int i = 0; i < perProducer; i++) {
+            EXPECT_EQ(all[p * perProducer + i], std::make_pair(p, i));
+        }
+    }
+}
+
+TEST(MpmcQueueTest, ManyThreadsDeliverEachValueOnce) {
+    const int producers = 4;
+    const int perProducer = 20000;
+    MpmcQueue queue(128);
+    std::atomic<int> remaining(producers * perProducer);
+    
+    checkManyThreadsDeliverEachValueOnce(producers, 3, perProducer,
+        [&queue](std::string value) {
+            while (!queue.tryEnqueue(std::move(value))) {
+                std::this_thread::yield();
+            }
+        },
+        [&queue, &remaining](std::string& out) {
+            // Потребитель завершается, когда все значения разобраны
+            while (remaining.load() > 0) {
+                if (queue.tryDequeue(out)) {
+                    remaining.fetch_sub(1);
+                    return true;
+                }
+                std::this_thread::yield();
+            }
+            return false;
+        },
+        []() {});
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(BlockingQueueTest, ParksAndWakesUntilClosed) {
+    // Ёмкость 2: производители упираются в полную очередь, потребители —
+    // в пустую, и обе стороны засыпают
+    BlockingQueue<MpmcQueue> queue(2);
+    checkManyThreadsDeliverEachValueOnce(3, 2, 5000,
+        [&queue](std::string value) { EXPECT_TRUE(queue.enqueue(std::move(value))); },
+        [&queue](std::string& out) { return queue.dequeue(out); },
+        [&queue]() { queue.close(); });
+    
+    EXPECT_TRUE(queue.isClosed());
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_FALSE(queue.enqueue("late"));
+    EXPECT_FALSE(queue.tryEnqueue("late"));
+    std::string out;
+    EXPECT_FALSE(queue.dequeue(out));
+}
+
+TEST(BlockingQueueTest, SingleProducerSingleConsumer) {
+    BlockingQueue<SpscQueue> queue(4);
+    checkManyThreadsDeliverEachValueOnce(1, 1, 20000,
+        [&queue](std::string value) { EXPECT_TRUE(queue.enqueue(std::move(value))); },
+        [&queue](std::string& out) { return queue.dequeue(out); },
+        [&queue]() { queue.close(); });
+    
+    // Оставшиеся после закрытия значения потребитель ещё забирает
+    BlockingQueue<SpscQueue> closing(4);
+    EXPECT_TRUE(closing.tryEnqueue("a"));
+    EXPECT_TRUE(closing.enqueue("b"));
+    closing.close();
+    std::string out;
+    EXPECT_TRUE(closing.dequeue(out));
+    EXPECT_EQ(out, "a");
+    EXPECT_TRUE(closing.tryDequeue(out));
+    EXPECT_EQ(out, "b");
+    EXPECT_FALSE(closing.dequeue(out));
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
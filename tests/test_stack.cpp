@@ -13,7 +13,7 @@ TEST(StackTest, Push) {
     stack.push("first");
     
     EXPECT_EQ(stack.getSize(), 1);
-    EXPECT_FALSE(stack.isEmpty()); 
+    EXPECT_FALSE(stack.isEmpty());
     
     stack.push("second");
     EXPECT_EQ(stack.getSize(), 2);
@@ -168,6 +168,97 @@ TEST(StackTest, LargeStack) {
     EXPECT_TRUE(stack.isEmpty());
 }
 
+TEST(StackTest, PooledAllocation) {
+    Stack stack(NodeAllocation::Pooled);
+    EXPECT_EQ(stack.getAllocation(), NodeAllocation::Pooled);
+    // Массиву пул не нужен
+    Stack contiguous(Stack::StorageMode::Contiguous, NodeAllocation::Pooled);
+    EXPECT_EQ(contiguous.getAllocation(), NodeAllocation::Heap);
+    
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 1000; i++) {
+            stack.push("value_" + std::to_string(i));
+        }
+        for (int i = 999; i >= 500; i--) {
+            EXPECT_EQ(stack.pop(), "value_" + std::to_string(i));
+        }
+        // Освобождённые блоки используются повторно
+        stack.push("again");
+        EXPECT_EQ(stack.peek(), "again");
+        EXPECT_EQ(stack.getSize(), 501);
+        
+        stack.clear();
+        EXPECT_TRUE(stack.isEmpty());
+        EXPECT_THROW(stack.pop(), std::runtime_error);
+    }
+}
+
+TEST(StackTest, ContiguousStorage) {
+    Stack stack(Stack::StorageMode::Contiguous);
+    EXPECT_EQ(stack.getStorageMode(), Stack::StorageMode::Contiguous);
+    EXPECT_THROW(stack.pop(), std::runtime_error);
+    EXPECT_THROW(stack.peek(), std::runtime_error);
+    
+    for (int i = 0; i < 1000; i++) {
+        stack.push("value_" + std::to_string(i));
+    }
+    EXPECT_EQ(stack.getSize(), 1000);
+    EXPECT_EQ(stack.peek(), "value_999");
+    size_t capacity = stack.getCapacity();
+    EXPECT_GE(capacity, 1000u);
+    
+    // Установившийся режим: ёмкость не меняется
+    for (int i = 0; i < 5000; i++) {
+        std::string value = "next_" + std::to_string(i);
+        stack.push(std::move(value));
+        EXPECT_EQ(stack.pop(), "next_" + std::to_string(i));
+    }
+    EXPECT_EQ(stack.getCapacity(), capacity);
+    
+    // Сериализация совместима с режимом Linked в обе стороны
+    stack.serializeToFile("test_contiguous_stack.bin");
+    Stack linked;
+    linked.deserializeFromFile("test_contiguous_stack.bin");
+    linked.serializeToFile("test_contiguous_stack.bin");
+    Stack contiguous(Stack::StorageMode::Contiguous);
+    contiguous.deserializeFromFile("test_contiguous_stack.bin");
+    remove("test_contiguous_stack.bin");
+    EXPECT_EQ(linked.getSize(), 1000);
+    for (int i = 999; i >= 0; i--) {
+        std::string expected = "value_" + std::to_string(i);
+        EXPECT_EQ(stack.pop(), expected);
+        EXPECT_EQ(linked.pop(), expected);
+        EXPECT_EQ(contiguous.pop(), expected);
+    }
+    
+    // Очистка сохраняет ёмкость
+    stack.push("a");
+    stack.clear();
+    EXPECT_TRUE(stack.isEmpty());
+    EXPECT_EQ(stack.getCapacity(), capacity);
+}
+
+TEST(StackTest, EmplaceAndMovePush) {
+    for (Stack::StorageMode mode : {Stack::StorageMode::Linked, Stack::StorageMode::Contiguous}) {
+        Stack stack(mode);
+        stack.emplace(100, 'x');
+        stack.emplace("literal");
+        std::string value(50, 'y');
+        stack.push(std::move(value));
+        
+        EXPECT_EQ(stack.getSize(), 3);
+        EXPECT_EQ(stack.pop(), std::string(50, 'y'));
+        EXPECT_EQ(stack.pop(), "literal");
+        EXPECT_EQ(stack.peek(), std::string(100, 'x'));
+        
+        testing::internal::CaptureStdout();
+        stack.push("top");
+        stack.print();
+        EXPECT_EQ(testing::internal::GetCapturedStdout(),
+                  "Top -> top -> " + std::string(100, 'x') + " -> Bottom\n");
+    }
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
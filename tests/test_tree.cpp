@@ -1,12 +1,20 @@
 #include <gtest/gtest.h>
 #include "../src/tree.h"
+#include "../src/ordered_tree.h"
+#include "../src/bplus_tree.h"
 #include <vector>
 #include <algorithm>
+#include <random>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <fstream>
+#include <iterator>
 
 TEST(TreeTest, DefaultConstructor) {
     Tree tree;
     EXPECT_TRUE(tree.isEmpty());
-    EXPECT_EQ(tree.size(), 0); 
+    EXPECT_EQ(tree.size(), 0);
     EXPECT_EQ(tree.height(), -1);
 }
 
@@ -170,7 +178,7 @@ TEST(TreeTest, IsFullBinaryTree) {
 }
 
 TEST(TreeTest, IsCompleteBinaryTree) {
-    // Test placeholder - implementation verification  
+    // Test placeholder - implementation verification
     Tree tree;
     tree.insert("A");
     tree.insert("B");
@@ -215,6 +223,103 @@ TEST(TreeTest, HeightCalculation) {
     EXPECT_GE(tree.height(), 1); // Минимум высота 1
 }
 
+// Высота, пересчитанная полным обходом, для сверки с кешированной
+template <typename Node>
+static int recomputeHeight(const Node* node) {
+    if (node == nullptr) {
+        return -1;
+    }
+    return 1 + std::max(recomputeHeight(node->left), recomputeHeight(node->right));
+}
+
+TEST(TreeTest, CachedHeightAfterInsertAndRemove) {
+    Tree tree;
+    for (int i = 0; i < 1000; i++) {
+        tree.insert("V" + std::to_string(i));
+    }
+    
+    // Вставка держит высоту логарифмической: для 1000 узлов log2 ~ 10
+    EXPECT_LE(tree.height(), 20);
+    EXPECT_EQ(tree.height(), recomputeHeight(tree.getRoot()));
+    
+    for (int i = 0; i < 1000; i += 3) {
+        tree.remove("V" + std::to_string(i));
+        ASSERT_EQ(tree.height(), recomputeHeight(tree.getRoot()));
+    }
+    
+    for (int i = 0; i < 200; i++) {
+        tree.insert("W" + std::to_string(i));
+    }
+    EXPECT_EQ(tree.height(), recomputeHeight(tree.getRoot()));
+}
+
+// Свойства формы, вычисленные заново обходом (определения через индексы)
+template <typename Node>
+static int recomputeSize(const Node* node) {
+    return node == nullptr ? 0 : 1 + recomputeSize(node->left) + recomputeSize(node->right);
+}
+
+template <typename Node>
+static bool recomputeFull(const Node* node) {
+    if (node == nullptr) return true;
+    if ((node->left == nullptr) != (node->right == nullptr)) return false;
+    return recomputeFull(node->left) && recomputeFull(node->right);
+}
+
+template <typename Node>
+static bool recomputeComplete(const Node* node, int index, int count) {
+    if (node == nullptr) return true;
+    if (index >= count) return false;
+    return recomputeComplete(node->left, 2 * index + 1, count) &&
+           recomputeComplete(node->right, 2 * index + 2, count);
+}
+
+static void expectCachedShape(const Tree& tree) {
+    int size = recomputeSize(tree.getRoot());
+    int height = recomputeHeight(tree.getRoot());
+    ASSERT_EQ(tree.size(), size);
+    ASSERT_EQ(tree.height(), height);
+    ASSERT_EQ(tree.isFullBinaryTree(), recomputeFull(tree.getRoot()));
+    ASSERT_EQ(tree.isCompleteBinaryTree(), recomputeComplete(tree.getRoot(), 0, size));
+    ASSERT_EQ(tree.isPerfectBinaryTree(), size == (1 << (height + 1)) - 1);
+}
+
+TEST(TreeTest, CachedShapeMatchesRecomputed) {
+    Tree tree;
+    std::mt19937 gen(5);
+    int perfectSeen = 0, completeSeen = 0, fullSeen = 0;
+    
+    for (int i = 0; i < 3000; i++) {
+        std::string value = "V" + std::to_string(gen() % 150);
+        if (gen() % 3 == 0) {
+            tree.remove(value);
+        } else {
+            tree.insert(value);
+        }
+        expectCachedShape(tree);
+        perfectSeen += tree.isPerfectBinaryTree();
+        completeSeen += tree.isCompleteBinaryTree();
+        fullSeen += tree.isFullBinaryTree();
+    }
+    
+    // Последовательность проходит и через деревья с каждым свойством
+    EXPECT_GT(perfectSeen, 0);
+    EXPECT_GT(completeSeen, perfectSeen);
+    EXPECT_GT(fullSeen, 0);
+    
+    // Кешированные значения переживают запись и чтение файла
+    tree.serializeToFile("test_shape_cache.bin");
+    Tree restored;
+    restored.deserializeFromFile("test_shape_cache.bin");
+    expectCachedShape(restored);
+    EXPECT_EQ(restored.size(), tree.size());
+    remove("test_shape_cache.bin");
+    
+    tree.clear();
+    expectCachedShape(tree);
+    EXPECT_TRUE(tree.isPerfectBinaryTree());
+}
+
 TEST(TreeTest, ClearTree) {
     Tree tree;
     tree.insert("A");
@@ -287,6 +392,94 @@ TEST(TreeTest, EmptyTreeSerialization) {
     remove("test_empty_tree.bin");
 }
 
+TEST(TreeTest, CompactSerializationKeepsShapeAndValues) {
+    // Значение "NULL", пустая строка и длина, занимающая два байта varint
+    Tree tree;
+    std::vector<std::string> values = {"NULL", "", "A", std::string(300, 'x'), "B", "C", "D"};
+    for (const auto& value : values) {
+        tree.insert(value);
+    }
+    tree.remove("A");
+    
+    tree.serializeToFile("test_compact_tree.bin");
+    Tree restored;
+    restored.deserializeFromFile("test_compact_tree.bin");
+    
+    EXPECT_EQ(restored.size(), tree.size());
+    EXPECT_EQ(restored.height(), tree.height());
+    EXPECT_EQ(restored.preorder(), tree.preorder());
+    EXPECT_EQ(restored.inorder(), tree.inorder());
+    EXPECT_EQ(restored.isFullBinaryTree(), tree.isFullBinaryTree());
+    EXPECT_EQ(restored.isCompleteBinaryTree(), tree.isCompleteBinaryTree());
+    EXPECT_TRUE(restored.search("NULL"));
+    EXPECT_TRUE(restored.search(""));
+    
+    // Заголовок 24 байта, два бита формы на узел, длины и значения
+    size_t blobSize = 0, lengthsSize = 0;
+    for (const auto& value : tree.levelOrder()) {
+        blobSize += value.size();
+        lengthsSize += value.size() < 128 ? 1 : 2;
+    }
+    std::ifstream file("test_compact_tree.bin", std::ios::binary | std::ios::ate);
+    EXPECT_EQ(static_cast<size_t>(file.tellg()),
+              24 + (2 * tree.size() + 7) / 8 + lengthsSize + blobSize);
+    file.close();
+    
+    remove("test_compact_tree.bin");
+}
+
+TEST(TreeTest, TruncatedCompactFileThrows) {
+    Tree tree;
+    for (int i = 0; i < 100; i++) {
+        tree.insert("value_" + std::to_string(i));
+    }
+    tree.serializeToFile("test_truncated_tree.bin");
+    
+    std::ifstream input("test_truncated_tree.bin", std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    input.close();
+    std::ofstream output("test_truncated_tree.bin", std::ios::binary);
+    output.write(contents.data(), contents.size() - 10);
+    output.close();
+    
+    // Частично прочитанные узлы освобождаются, дерево остаётся пустым
+    Tree restored;
+    EXPECT_THROW(restored.deserializeFromFile("test_truncated_tree.bin"), std::runtime_error);
+    EXPECT_TRUE(restored.isEmpty());
+    EXPECT_EQ(restored.size(), 0);
+    
+    Tree implicit(Tree::StorageMode::Implicit);
+    EXPECT_THROW(implicit.deserializeFromFile("test_truncated_tree.bin"), std::runtime_error);
+    EXPECT_TRUE(implicit.isEmpty());
+    
+    remove("test_truncated_tree.bin");
+}
+
+TEST(TreeTest, HugeCountCompactHeaderThrows) {
+    // Заголовок обещает почти 4 млрд узлов, а данных в файле нет
+    std::ofstream output("test_huge_tree.bin", std::ios::binary);
+    const uint32_t magic = 0x4354334C;
+    const uint32_t count = 0xFFFFFFF0;
+    const uint64_t lengthsSize = count;
+    const uint64_t blobSize = 0;
+    output.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    output.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    output.write(reinterpret_cast<const char*>(&lengthsSize), sizeof(lengthsSize));
+    output.write(reinterpret_cast<const char*>(&blobSize), sizeof(blobSize));
+    output.write("\x01\x02\x03\x04", 4);
+    output.close();
+    
+    Tree tree;
+    EXPECT_THROW(tree.deserializeFromFile("test_huge_tree.bin"), std::runtime_error);
+    EXPECT_TRUE(tree.isEmpty());
+    
+    Tree implicit(Tree::StorageMode::Implicit);
+    EXPECT_THROW(implicit.deserializeFromFile("test_huge_tree.bin"), std::runtime_error);
+    EXPECT_TRUE(implicit.isEmpty());
+    
+    remove("test_huge_tree.bin");
+}
+
 TEST(TreeTest, ComplexOperations) {
     Tree tree;
     
@@ -317,6 +510,586 @@ TEST(TreeTest, ComplexOperations) {
     EXPECT_EQ(tree.levelOrder().size(), 23);
 }
 
+// Файл сериализации вырожденного дерева: цепочка из count узлов,
+// у каждого только левый потомок
+static void writeChainFile(const std::string& filename, int count) {
+    std::ofstream file(filename, std::ios::binary);
+    int dataSize = 2 * count + 1;
+    file.write(reinterpret_cast<const char*>(&dataSize), sizeof(dataSize));
+    for (int i = 0; i < dataSize; i++) {
+        std::string value = i < count ? "node_" + std::to_string(i) : "NULL";
+        int strSize = value.size();
+        file.write(reinterpret_cast<const char*>(&strSize), sizeof(strSize));
+        file.write(value.c_str(), strSize);
+    }
+}
+
+TEST(TreeTest, DegenerateTreeIsStackSafe) {
+    // Рекурсивные обходы на такой глубине переполнили бы стек
+    const int depth = 1000000;
+    writeChainFile("test_chain_tree.bin", depth);
+    
+    {
+        Tree tree;
+        tree.deserializeFromFile("test_chain_tree.bin");
+        EXPECT_EQ(tree.size(), depth);
+        EXPECT_EQ(tree.height(), depth - 1);
+        EXPECT_FALSE(tree.isFullBinaryTree());
+        EXPECT_FALSE(tree.isCompleteBinaryTree());
+        EXPECT_FALSE(tree.isPerfectBinaryTree());
+        EXPECT_TRUE(tree.search("node_999999"));
+        
+        std::vector<std::string> inorder = tree.inorder();
+        ASSERT_EQ(inorder.size(), static_cast<size_t>(depth));
+        EXPECT_EQ(inorder.front(), "node_999999");
+        EXPECT_EQ(tree.preorder().front(), "node_0");
+        EXPECT_EQ(tree.postorder().back(), "node_0");
+        EXPECT_EQ(std::distance(tree.begin(Tree::TraversalOrder::Postorder), tree.end()), depth);
+        
+        // Узел с одним потомком посередине цепочки
+        tree.remove("node_500000");
+        EXPECT_EQ(tree.size(), depth - 1);
+        EXPECT_EQ(tree.height(), depth - 2);
+        EXPECT_FALSE(tree.search("node_500000"));
+        
+        // Запись и повторное чтение, затем уничтожение в деструкторе
+        tree.serializeToFile("test_chain_tree.bin");
+        Tree restored;
+        restored.deserializeFromFile("test_chain_tree.bin");
+        EXPECT_EQ(restored.size(), depth - 1);
+        EXPECT_EQ(restored.height(), depth - 2);
+    }
+    
+    remove("test_chain_tree.bin");
+}
+
+TEST(TreeTest, IterativeTraversalsMatchShape) {
+    // Дерево с узлами, у которых только правый потомок
+    const char* data[] = {"A", "B", "NULL", "D", "NULL", "NULL", "C", "E", "NULL", "NULL", "F",
+                          "NULL", "NULL"};
+    std::ofstream file("test_shape_tree.bin", std::ios::binary);
+    int dataSize = sizeof(data) / sizeof(data[0]);
+    file.write(reinterpret_cast<const char*>(&dataSize), sizeof(dataSize));
+    for (const char* value : data) {
+        int strSize = std::string(value).size();
+        file.write(reinterpret_cast<const char*>(&strSize), sizeof(strSize));
+        file.write(value, strSize);
+    }
+    file.close();
+    
+    Tree tree;
+    tree.deserializeFromFile("test_shape_tree.bin");
+    EXPECT_EQ(tree.preorder(), std::vector<std::string>({"A", "B", "D", "C", "E", "F"}));
+    EXPECT_EQ(tree.inorder(), std::vector<std::string>({"B", "D", "A", "E", "C", "F"}));
+    EXPECT_EQ(tree.postorder(), std::vector<std::string>({"D", "B", "E", "F", "C", "A"}));
+    EXPECT_EQ(tree.levelOrder(), std::vector<std::string>({"A", "B", "C", "D", "E", "F"}));
+    EXPECT_EQ(tree.height(), 2);
+    EXPECT_FALSE(tree.isFullBinaryTree());
+    EXPECT_FALSE(tree.isCompleteBinaryTree());
+    
+    testing::internal::CaptureStdout();
+    tree.printTree();
+    EXPECT_EQ(testing::internal::GetCapturedStdout(),
+              "Binary Tree Structure:\n"
+              "        ┌── F\n"
+              "    ┌── C\n"
+              "        └── E\n"
+              "A\n"
+              "        ┌── D\n"
+              "    └── B\n");
+    
+    // Удаление корня с двумя потомками переносит в него минимум правого поддерева
+    tree.remove("A");
+    EXPECT_EQ(tree.preorder(), std::vector<std::string>({"C", "B", "D", "F", "E"}));
+    EXPECT_EQ(tree.height(), 2);
+    
+    remove("test_shape_tree.bin");
+}
+
+TEST(TreeTest, IteratorsMatchTraversals) {
+    const Tree::TraversalOrder orders[] = {
+        Tree::TraversalOrder::Preorder, Tree::TraversalOrder::Inorder,
+        Tree::TraversalOrder::Postorder, Tree::TraversalOrder::LevelOrder
+    };
+    
+    for (Tree::StorageMode mode : {Tree::StorageMode::Linked, Tree::StorageMode::Implicit}) {
+        Tree tree(mode);
+        EXPECT_TRUE(tree.begin() == tree.end());
+        // Концы обхода разных деревьев не равны
+        Tree other(mode);
+        EXPECT_TRUE(tree.end() != other.end());
+        
+        for (int i = 0; i < 100; i++) {
+            tree.insert("node_" + std::to_string(i));
+        }
+        tree.remove("node_42");
+        
+        const std::vector<std::string> expected[] = {
+            tree.preorder(), tree.inorder(), tree.postorder(), tree.levelOrder()
+        };
+        for (int i = 0; i < 4; i++) {
+            std::vector<std::string> lazy;
+            for (const std::string& value : tree.traverse(orders[i])) {
+                lazy.push_back(value);
+            }
+            EXPECT_EQ(lazy, expected[i]);
+            EXPECT_EQ(std::distance(tree.begin(orders[i]), tree.end()), 99);
+        }
+    }
+}
+
+TEST(TreeTest, IteratorsStopEarly) {
+    Tree tree;
+    for (char c = 'A'; c <= 'G'; c++) {
+        tree.insert(std::string(1, c));
+    }
+    
+    // Стандартные алгоритмы работают с итераторами
+    Tree::const_iterator it = std::find(tree.begin(Tree::TraversalOrder::LevelOrder), tree.end(), "C");
+    ASSERT_TRUE(it != tree.end());
+    EXPECT_EQ(*it, "C");
+    EXPECT_EQ(it->size(), 1u);
+    Tree::const_iterator previous = it++;
+    EXPECT_EQ(*previous, "C");
+    EXPECT_EQ(*it, "D");
+    
+    std::vector<std::string> visited;
+    tree.forEach(Tree::TraversalOrder::Preorder, [&visited](const std::string& value) {
+        visited.push_back(value);
+        return visited.size() < 3;
+    });
+    EXPECT_EQ(visited, std::vector<std::string>({"A", "B", "D"}));
+    
+    int count = 0;
+    tree.forEach(Tree::TraversalOrder::Postorder, [&count](const std::string&) {
+        count++;
+        return true;
+    });
+    EXPECT_EQ(count, 7);
+}
+
+TEST(TreeTest, ImplicitStorageMatchesLinked) {
+    Tree linked;
+    Tree implicit(Tree::StorageMode::Implicit);
+    EXPECT_EQ(implicit.getStorageMode(), Tree::StorageMode::Implicit);
+    EXPECT_TRUE(implicit.isEmpty());
+    EXPECT_EQ(implicit.height(), -1);
+    EXPECT_EQ(implicit.getRoot(), nullptr);
+    
+    // До 3 узлов обе раскладки дают одинаковое полное дерево
+    for (const char* value : {"A", "B", "C"}) {
+        linked.insert(value);
+        implicit.insert(value);
+    }
+    EXPECT_EQ(implicit.inorder(), linked.inorder());
+    EXPECT_EQ(implicit.preorder(), linked.preorder());
+    EXPECT_EQ(implicit.postorder(), linked.postorder());
+    EXPECT_EQ(implicit.levelOrder(), linked.levelOrder());
+    EXPECT_TRUE(implicit.isPerfectBinaryTree());
+    
+    // Дальше неявное дерево заполняет уровни строго слева направо
+    for (const char* value : {"D", "E", "F"}) {
+        implicit.insert(value);
+    }
+    EXPECT_EQ(implicit.size(), 6);
+    EXPECT_EQ(implicit.height(), 2);
+    EXPECT_EQ(implicit.levelOrder(), std::vector<std::string>({"A", "B", "C", "D", "E", "F"}));
+    EXPECT_EQ(implicit.inorder(), std::vector<std::string>({"D", "B", "E", "A", "F", "C"}));
+    EXPECT_EQ(implicit.preorder(), std::vector<std::string>({"A", "B", "D", "E", "C", "F"}));
+    EXPECT_EQ(implicit.postorder(), std::vector<std::string>({"D", "E", "B", "F", "C", "A"}));
+    EXPECT_TRUE(implicit.isCompleteBinaryTree());
+    EXPECT_FALSE(implicit.isFullBinaryTree());
+    EXPECT_FALSE(implicit.isPerfectBinaryTree());
+    
+    implicit.insert("G");
+    EXPECT_TRUE(implicit.isFullBinaryTree());
+    EXPECT_TRUE(implicit.isPerfectBinaryTree());
+    EXPECT_TRUE(implicit.search("G"));
+    EXPECT_FALSE(implicit.search("Z"));
+    
+    testing::internal::CaptureStdout();
+    implicit.printTree();
+    EXPECT_NE(testing::internal::GetCapturedStdout().find("G"), std::string::npos);
+}
+
+TEST(TreeTest, ImplicitStorageRemoveKeepsComplete) {
+    Tree tree(Tree::StorageMode::Implicit);
+    for (char c = 'A'; c <= 'J'; c++) {
+        tree.insert(std::string(1, c));
+    }
+    
+    // Удалённый узел замещается последним
+    tree.remove("B");
+    EXPECT_EQ(tree.levelOrder(),
+              std::vector<std::string>({"A", "J", "C", "D", "E", "F", "G", "H", "I"}));
+    tree.remove("I");
+    tree.remove("Z");
+    EXPECT_EQ(tree.size(), 8);
+    EXPECT_FALSE(tree.search("B"));
+    EXPECT_FALSE(tree.search("I"));
+    EXPECT_TRUE(tree.isCompleteBinaryTree());
+    
+    tree.clear();
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_EQ(tree.size(), 0);
+}
+
+TEST(TreeTest, ImplicitStorageSerialization) {
+    Tree implicit(Tree::StorageMode::Implicit);
+    for (int i = 0; i < 100; i++) {
+        implicit.insert("node_" + std::to_string(i));
+    }
+    implicit.serializeToFile("test_implicit_tree.bin");
+    
+    // Формат файла общий: связное дерево читает неявное и наоборот
+    Tree linked;
+    linked.deserializeFromFile("test_implicit_tree.bin");
+    EXPECT_EQ(linked.levelOrder(), implicit.levelOrder());
+    EXPECT_EQ(linked.inorder(), implicit.inorder());
+    EXPECT_TRUE(linked.isCompleteBinaryTree());
+    
+    linked.serializeToFile("test_implicit_tree.bin");
+    Tree restored(Tree::StorageMode::Implicit);
+    restored.deserializeFromFile("test_implicit_tree.bin");
+    EXPECT_EQ(restored.preorder(), implicit.preorder());
+    EXPECT_EQ(restored.postorder(), implicit.postorder());
+    EXPECT_EQ(restored.getRoot(), nullptr);
+    
+    remove("test_implicit_tree.bin");
+}
+
+template <typename Node>
+static int checkAvl(const Node* node) {
+    if (node == nullptr) return -1;
+    int left = checkAvl(node->left);
+    int right = checkAvl(node->right);
+    EXPECT_LE(std::abs(left - right), 1);
+    EXPECT_EQ(node->height, 1 + std::max(left, right));
+    return node->height;
+}
+
+TEST(TreeTest, ParallelBuildMatchesImplicitLayout) {
+    for (int count : {0, 1, 2, 7, 100, 1000, 4097}) {
+        std::vector<std::string> values;
+        for (int i = 0; i < count; i++) {
+            values.push_back("value_" + std::to_string(i));
+        }
+        
+        Tree implicit(Tree::StorageMode::Implicit);
+        implicit.buildFrom(values);
+        
+        for (unsigned threads : {1u, 2u, 3u, 8u}) {
+            Tree tree;
+            tree.insert("old");
+            tree.buildFrom(values, threads);
+            
+            EXPECT_EQ(tree.size(), count);
+            EXPECT_EQ(tree.levelOrder(), values);
+            EXPECT_EQ(tree.inorder(), implicit.inorder());
+            EXPECT_EQ(tree.height(), implicit.height());
+            EXPECT_TRUE(tree.isCompleteBinaryTree());
+            EXPECT_EQ(tree.isFullBinaryTree(), implicit.isFullBinaryTree());
+            EXPECT_EQ(tree.isPerfectBinaryTree(), implicit.isPerfectBinaryTree());
+            EXPECT_FALSE(tree.search("old"));
+        }
+    }
+}
+
+TEST(TreeTest, ParallelReduceMatchesSequential) {
+    // Неполное дерево после удалений и то же множество в режиме Implicit
+    Tree linked;
+    Tree implicit(Tree::StorageMode::Implicit);
+    for (int i = 0; i < 3000; i++) {
+        linked.insert("item_" + std::to_string(i));
+        implicit.insert("item_" + std::to_string(i));
+    }
+    for (int i = 0; i < 3000; i += 7) {
+        linked.remove("item_" + std::to_string(i));
+    }
+    
+    for (const Tree* tree : {&linked, &implicit}) {
+        size_t expectedCount = 0, expectedLength = 0;
+        for (const auto& value : tree->traverse(Tree::TraversalOrder::Preorder)) {
+            expectedCount += value.back() == '3';
+            expectedLength += value.size();
+        }
+        
+        for (unsigned threads : {1u, 2u, 5u, 16u}) {
+            auto endsWith3 = [](const std::string& value) { return value.back() == '3'; };
+            EXPECT_EQ(tree->parallelCount(endsWith3, threads), expectedCount);
+            EXPECT_EQ(tree->parallelReduce(static_cast<size_t>(0),
+                                           [](const std::string& value) { return value.size(); },
+                                           [](size_t a, size_t b) { return a + b; }, threads),
+                      expectedLength);
+            EXPECT_TRUE(tree->parallelAny([](const std::string& value) {
+                return value == "item_2999";
+            }, threads));
+            EXPECT_FALSE(tree->parallelAny([](const std::string& value) {
+                return value == "missing";
+            }, threads));
+        }
+    }
+    
+    Tree empty;
+    EXPECT_EQ(empty.parallelCount([](const std::string&) { return true; }, 4), 0u);
+    EXPECT_FALSE(empty.parallelAny([](const std::string&) { return true; }, 4));
+}
+
+TEST(TreeTest, ParallelReducePropagatesExceptions) {
+    Tree tree;
+    tree.buildFrom(std::vector<std::string>(1000, "x"), 4);
+    EXPECT_THROW(tree.parallelCount([](const std::string&) -> bool {
+        throw std::runtime_error("predicate failed");
+    }, 4), std::runtime_error);
+}
+
+TEST(TreeTest, PooledAllocationMatchesHeap) {
+    Tree heap;
+    Tree pooled(Tree::StorageMode::Linked, NodeAllocation::Pooled);
+    EXPECT_EQ(pooled.getAllocation(), NodeAllocation::Pooled);
+    EXPECT_EQ(heap.getAllocation(), NodeAllocation::Heap);
+    // Неявному дереву пул не нужен
+    Tree implicit(Tree::StorageMode::Implicit, NodeAllocation::Pooled);
+    EXPECT_EQ(implicit.getAllocation(), NodeAllocation::Heap);
+    
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < 2000; i++) {
+            heap.insert("item_" + std::to_string(i));
+            pooled.insert("item_" + std::to_string(i));
+        }
+        for (int i = 0; i < 2000; i += 3) {
+            heap.remove("item_" + std::to_string(i));
+            pooled.remove("item_" + std::to_string(i));
+        }
+        EXPECT_EQ(pooled.preorder(), heap.preorder());
+        EXPECT_EQ(pooled.height(), heap.height());
+        
+        pooled.serializeToFile("test_pooled_tree.bin");
+        pooled.deserializeFromFile("test_pooled_tree.bin");
+        EXPECT_EQ(pooled.preorder(), heap.preorder());
+        
+        heap.clear();
+        pooled.clear();
+        EXPECT_TRUE(pooled.isEmpty());
+    }
+    
+    // Параллельное построение в пуле: блоки выделяются заранее
+    std::vector<std::string> values;
+    for (int i = 0; i < 5000; i++) {
+        values.push_back("value_" + std::to_string(i));
+    }
+    pooled.buildFrom(values, 4);
+    EXPECT_EQ(pooled.levelOrder(), values);
+    EXPECT_TRUE(pooled.isCompleteBinaryTree());
+    
+    remove("test_pooled_tree.bin");
+}
+
+TEST(OrderedTreeTest, BasicOperations) {
+    OrderedTree tree;
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_EQ(tree.height(), -1);
+    EXPECT_EQ(tree.lowerBound("A"), nullptr);
+    
+    for (const char* value : {"M", "C", "X", "A", "E", "Q", "Z", "C"}) {
+        tree.insert(value);
+    }
+    
+    // Повторная вставка не создаёт дубликатов
+    EXPECT_EQ(tree.size(), 7);
+    EXPECT_EQ(tree.inorder(), std::vector<std::string>({"A", "C", "E", "M", "Q", "X", "Z"}));
+    EXPECT_TRUE(tree.search("E"));
+    EXPECT_FALSE(tree.search("B"));
+    
+    tree.remove("M");
+    tree.remove("B");
+    EXPECT_EQ(tree.size(), 6);
+    EXPECT_FALSE(tree.search("M"));
+    EXPECT_EQ(tree.inorder(), std::vector<std::string>({"A", "C", "E", "Q", "X", "Z"}));
+    
+    tree.clear();
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_EQ(tree.size(), 0);
+}
+
+TEST(OrderedTreeTest, OrderedQueries) {
+    OrderedTree tree;
+    for (const char* value : {"apple", "banana", "cherry", "date", "fig", "grape"}) {
+        tree.insert(value);
+    }
+    
+    ASSERT_NE(tree.lowerBound("c"), nullptr);
+    EXPECT_EQ(*tree.lowerBound("c"), "cherry");
+    EXPECT_EQ(*tree.lowerBound("date"), "date");
+    EXPECT_EQ(*tree.lowerBound(""), "apple");
+    EXPECT_EQ(tree.lowerBound("zebra"), nullptr);
+    
+    EXPECT_EQ(tree.kth(0), "apple");
+    EXPECT_EQ(tree.kth(3), "date");
+    EXPECT_EQ(tree.kth(5), "grape");
+    EXPECT_THROW(tree.kth(6), std::out_of_range);
+    EXPECT_THROW(tree.kth(-1), std::out_of_range);
+    
+    EXPECT_EQ(tree.rank("apple"), 0);
+    EXPECT_EQ(tree.rank("coconut"), 3);
+    EXPECT_EQ(tree.rank("zebra"), 6);
+    
+    // Полуинтервал [low, high)
+    EXPECT_EQ(tree.range("b", "fig"), std::vector<std::string>({"banana", "cherry", "date"}));
+    EXPECT_EQ(tree.range("fig", "zzz"), std::vector<std::string>({"fig", "grape"}));
+    EXPECT_TRUE(tree.range("h", "z").empty());
+    EXPECT_TRUE(tree.range("date", "date").empty());
+    
+    int visited = 0;
+    tree.forEachInRange("a", "c", [&visited](const std::string&) { visited++; });
+    EXPECT_EQ(visited, 2);
+}
+
+TEST(OrderedTreeTest, StaysBalancedAgainstStdSet) {
+    OrderedTree tree;
+    std::set<std::string> reference;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dis(0, 1999);
+    
+    for (int i = 0; i < 20000; i++) {
+        std::string value = "key_" + std::to_string(dis(gen));
+        if (i % 3 == 2) {
+            tree.remove(value);
+            reference.erase(value);
+        } else {
+            tree.insert(value);
+            reference.insert(value);
+        }
+    }
+    
+    EXPECT_EQ(tree.size(), static_cast<int>(reference.size()));
+    EXPECT_EQ(tree.inorder(), std::vector<std::string>(reference.begin(), reference.end()));
+    checkAvl(tree.getRoot());
+    
+    // Сортированная вставка не вырождает дерево в список
+    OrderedTree sorted;
+    for (int i = 0; i < 1023; i++) {
+        char buffer[16];
+        snprintf(buffer, sizeof(buffer), "%06d", i);
+        sorted.insert(buffer);
+    }
+    EXPECT_LE(sorted.height(), 14);
+    EXPECT_EQ(sorted.kth(500), "000500");
+    EXPECT_EQ(sorted.rank("000500"), 500);
+}
+
+TEST(BPlusTreeTest, BasicOperations) {
+    BPlusTree tree;
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_EQ(tree.height(), -1);
+    EXPECT_EQ(tree.search("missing"), "Not Found");
+    
+    tree.insert("apple", "red");
+    tree.insert("banana", "yellow");
+    tree.insert("apricot", "orange");
+    tree.insert("apple", "green");
+    
+    EXPECT_EQ(tree.getSize(), 3);
+    EXPECT_EQ(tree.height(), 0);
+    EXPECT_EQ(tree.search("apple"), "green");
+    EXPECT_EQ(tree.search("apricot"), "orange");
+    EXPECT_TRUE(tree.contains("banana"));
+    EXPECT_FALSE(tree.contains("app"));
+    EXPECT_FALSE(tree.contains("apples"));
+    EXPECT_EQ(tree.find("cherry"), nullptr);
+    
+    tree.remove("apple");
+    tree.remove("cherry");
+    EXPECT_EQ(tree.getSize(), 2);
+    EXPECT_FALSE(tree.contains("apple"));
+    
+    tree.clear();
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_FALSE(tree.contains("banana"));
+}
+
+TEST(BPlusTreeTest, SplitsAndRangeScans) {
+    BPlusTree tree;
+    std::map<std::string, std::string> reference;
+    
+    // Ключи с длинным общим префиксом в случайном порядке
+    std::vector<int> order(5000);
+    for (int i = 0; i < 5000; i++) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937(7));
+    for (int i : order) {
+        std::string key = "catalog/item/" + std::to_string(i);
+        tree.insert(key, std::to_string(i));
+        reference[key] = std::to_string(i);
+    }
+    
+    EXPECT_EQ(tree.getSize(), 5000);
+    EXPECT_GE(tree.height(), 2);
+    EXPECT_EQ(tree.search("catalog/item/4321"), "4321");
+    
+    // Полный обход идёт по связанным листьям в порядке ключей
+    auto expected = reference.begin();
+    tree.forEach([&](const std::string& key, const std::string& value) {
+        ASSERT_NE(expected, reference.end());
+        EXPECT_EQ(key, expected->first);
+        EXPECT_EQ(value, expected->second);
+        ++expected;
+    });
+    EXPECT_EQ(expected, reference.end());
+    
+    // Полуинтервал [low, high) захватывает соседние листья
+    std::vector<std::string> keys;
+    tree.forEachInRange("catalog/item/12", "catalog/item/13", [&keys](const std::string& key,
+                                                                     const std::string&) {
+        keys.push_back(key);
+    });
+    std::vector<std::string> expectedKeys;
+    for (auto it = reference.lower_bound("catalog/item/12");
+         it != reference.lower_bound("catalog/item/13"); ++it) {
+        expectedKeys.push_back(it->first);
+    }
+    EXPECT_EQ(keys, expectedKeys);
+    EXPECT_EQ(keys.size(), 111u);
+    
+    int visited = 0;
+    tree.forEachInRange("z", "zz", [&visited](const std::string&, const std::string&) { visited++; });
+    EXPECT_EQ(visited, 0);
+}
+
+TEST(BPlusTreeTest, RemoveAgainstStdMap) {
+    BPlusTree tree;
+    std::map<std::string, std::string> reference;
+    std::mt19937 gen(11);
+    
+    for (int i = 0; i < 50000; i++) {
+        int r = gen() % 4000;
+        std::string key = (r % 2 ? "user:" : "u") + std::to_string(r * 7919);
+        if (gen() % 3 == 0) {
+            tree.remove(key);
+            reference.erase(key);
+        } else {
+            tree.insert(key, std::to_string(i));
+            reference[key] = std::to_string(i);
+        }
+    }
+    
+    EXPECT_EQ(tree.getSize(), static_cast<int>(reference.size()));
+    for (const auto& entry : reference) {
+        ASSERT_NE(tree.find(entry.first), nullptr);
+        EXPECT_EQ(*tree.find(entry.first), entry.second);
+    }
+    
+    // Удаление всех ключей освобождает все узлы
+    for (const auto& entry : reference) {
+        tree.remove(entry.first);
+    }
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_EQ(tree.height(), -1);
+    tree.insert("again", "1");
+    EXPECT_EQ(tree.search("again"), "1");
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();